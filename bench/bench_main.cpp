@@ -0,0 +1,670 @@
+/**
+ * RUNE Plugin SDK - Plugin benchmarks
+ *
+ * Loads the example plugins into a MockHost and times their node vtables in
+ * tight loops with synthetic inputs. Reports per benchmark:
+ *   ns/op      - wall time per operation
+ *   ops/s      - throughput
+ *   host/op    - allocations through host services (alloc, pools, buffers, arenas)
+ *   heap/op    - global operator new calls (plugin and mock host combined)
+ *
+ * Usage: rune_plugin_bench [--iterations N] [--filter SUBSTRING]
+ */
+
+#include "mock_host.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+using rune::mock::MockExecContext;
+using rune::mock::MockHost;
+using rune::mock::MockSerializeWriter;
+using rune::mock::PluginLibrary;
+
+/* ==========================================================================
+ * Heap allocation counter
+ * ========================================================================== */
+
+static std::atomic<uint64_t> g_heap_allocs(0);
+
+void* operator new(std::size_t size) {
+    g_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+/* ==========================================================================
+ * Harness
+ * ========================================================================== */
+
+struct Options {
+    uint64_t iterations = 200000;
+    const char* filter = nullptr;
+};
+
+struct Benchmark {
+    std::string name;
+    uint64_t iterations;               /* 0 = Options::iterations */
+    std::function<void()> setup;       /* Optional, untimed */
+    std::function<bool()> run;         /* One operation */
+    std::function<void()> teardown;    /* Optional, untimed */
+};
+
+static int run_benchmark(MockHost& host, const Benchmark& bench, const Options& options) {
+    if (options.filter && bench.name.find(options.filter) == std::string::npos) {
+        return 0;
+    }
+
+    uint64_t iterations = bench.iterations ? bench.iterations : options.iterations;
+    if (bench.setup) {
+        bench.setup();
+    }
+
+    // Warm up caches and instance state before timing
+    uint64_t warmup = iterations / 10 + 1;
+    for (uint64_t i = 0; i < warmup; ++i) {
+        if (!bench.run()) {
+            std::fprintf(stderr, "%s: operation failed\n", bench.name.c_str());
+            if (bench.teardown) {
+                bench.teardown();
+            }
+            return 1;
+        }
+    }
+
+    host.reset_counters();
+    uint64_t heap_before = g_heap_allocs.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        bench.run();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t heap_allocs = g_heap_allocs.load(std::memory_order_relaxed) - heap_before;
+    MockHost::Counters counters = host.counters();
+
+    if (bench.teardown) {
+        bench.teardown();
+    }
+
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    double ns_per_op = ns / (double)iterations;
+    std::printf("%-40s %12.1f %14.0f %10.2f %10.2f\n",
+                bench.name.c_str(),
+                ns_per_op,
+                ns_per_op > 0.0 ? 1e9 / ns_per_op : 0.0,
+                (double)counters.allocs / (double)iterations,
+                (double)heap_allocs / (double)iterations);
+    return 0;
+}
+
+/* Shared state for benchmarks that execute one node instance */
+struct NodeFixture {
+    const MockHost::RegisteredNode* node = nullptr;
+    MockExecContext* ctx = nullptr;
+    void* inst = nullptr;
+
+    bool bind(MockHost& host, const char* unique_name) {
+        node = host.find_node(unique_name);
+        if (!node) {
+            std::fprintf(stderr, "node not registered: %s\n", unique_name);
+            return false;
+        }
+        ctx = new MockExecContext(host, node->desc);
+        inst = stateless() || !node->vtbl->create_instance ? nullptr : node->vtbl->create_instance();
+        return true;
+    }
+
+    // Version 2 hosts skip the instance lifecycle for these types
+    bool stateless() const {
+        return (node->desc->flags & NODE_FLAG_STATELESS) != 0;
+    }
+
+    void release() {
+        if (node && !stateless() && node->vtbl->destroy_instance) {
+            node->vtbl->destroy_instance(inst);
+        }
+        delete ctx;
+        node = nullptr;
+        ctx = nullptr;
+        inst = nullptr;
+    }
+
+    bool execute() {
+        return node->vtbl->execute(inst, ctx->get());
+    }
+};
+
+/* ==========================================================================
+ * Baseline benchmarks for the example plugins
+ * ========================================================================== */
+
+static void add_math_benchmarks(MockHost& host, std::vector<Benchmark>& out) {
+    static NodeFixture fx;
+
+    const char* binary_nodes[] = {"add", "multiply", "divide", "power"};
+    for (const char* op : binary_nodes) {
+        std::string unique = std::string("com.rune.example.math.") + op;
+        out.push_back(Benchmark{
+            "math." + std::string(op) + ".execute", 0,
+            [&host, unique]() {
+                if (fx.bind(host, unique.c_str())) {
+                    const bool power = unique.find("power") != std::string::npos;
+                    fx.ctx->set_input_float(power ? "Base" : "A", 3.5);
+                    fx.ctx->set_input_float(power ? "Exponent" : "B", 1.25);
+                }
+            },
+            []() { return fx.node && fx.execute(); },
+            []() { fx.release(); }});
+    }
+
+    // Luau fast call of the same operation, as the VM makes it: one direct
+    // call with unboxed arguments, to compare against math.power.execute
+    typedef double (*BinaryFastcall)(double, double);
+    static BinaryFastcall power_fastcall = nullptr;
+    out.push_back(Benchmark{
+        "math.power.luau_fastcall", 0,
+        [&host]() {
+            const MockHost::Fastcall* f = host.find_fastcall("rune_math", "power");
+            power_fastcall = f && f->signature == "dd->d" ? (BinaryFastcall)f->fn : nullptr;
+        },
+        []() {
+            volatile double base = 3.5;
+            volatile double exponent = 1.25;
+            return power_fastcall && power_fastcall(base, exponent) > 0.0;
+        },
+        []() { power_fastcall = nullptr; }});
+
+    // (A + B) * B, then ^ B: three pure-data nodes through execute, and the
+    // same chain through their IR with the reference interpreter. The IR
+    // run also checks that it reproduces execute's result.
+    static NodeFixture chain[3];
+    static const char* chain_nodes[] = {"com.rune.example.math.add", "com.rune.example.math.multiply",
+                                        "com.rune.example.math.power"};
+    static double chain_expected = 0.0;
+    enum { CHAIN_PIN_A = 0, CHAIN_PIN_B = 1, CHAIN_PIN_RESULT = 2 };  // Shared by all math nodes
+    auto bind_chain = [&host]() {
+        for (int i = 0; i < 3; ++i) {
+            if (!chain[i].bind(host, chain_nodes[i])) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto release_chain = []() {
+        for (NodeFixture& node : chain) {
+            node.release();
+        }
+    };
+    auto run_chain = []() {
+        const double b = 1.25;
+        double value = 3.5;
+        for (NodeFixture& node : chain) {
+            // The mock keeps one slot per pin, so the host-side writes to the
+            // inputs go through the same setters the plugin uses
+            ExecContext* ctx = node.ctx->get();
+            ctx->set_output_float_h(ctx, CHAIN_PIN_A, value);
+            ctx->set_output_float_h(ctx, CHAIN_PIN_B, b);
+            if (!node.execute()) {
+                return -1.0;
+            }
+            value = ctx->get_input_float_h(ctx, CHAIN_PIN_RESULT);
+        }
+        return value;
+    };
+
+    out.push_back(Benchmark{
+        "math.chain3.execute", 0,
+        [bind_chain]() { bind_chain(); },
+        [run_chain]() { return chain[2].node && run_chain() > 0.0; },
+        release_chain});
+
+    out.push_back(Benchmark{
+        "math.chain3.ir_eval", 0,
+        [bind_chain, run_chain]() { chain_expected = bind_chain() ? run_chain() : -1.0; },
+        []() {
+            double pins[3] = {3.5, 1.25, 0.0};
+            for (NodeFixture& node : chain) {
+                if (!node.node || !node.node->desc->ir ||
+                    !rune_ir_eval(node.node->desc->ir, pins, pins, 3)) {
+                    return false;
+                }
+                pins[CHAIN_PIN_A] = pins[CHAIN_PIN_RESULT];
+            }
+            return pins[CHAIN_PIN_RESULT] == chain_expected;
+        },
+        release_chain});
+
+    // execute_batch over a column block, reported per batch
+    static const uint32_t BATCH_ROWS = 1024;
+    static std::vector<double> columns_storage;
+    static void* columns[3];
+    static BatchContext batch;
+    out.push_back(Benchmark{
+        "math.add.execute_batch/1024", 0,
+        [&host]() {
+            if (!fx.bind(host, "com.rune.example.math.add") || !fx.node->vtbl->execute_batch) {
+                fx.release();
+                return;
+            }
+            // One allocation for all three columns, each RUNE_BATCH_ALIGNMENT aligned
+            const size_t stride = BATCH_ROWS + RUNE_BATCH_ALIGNMENT / sizeof(double);
+            columns_storage.assign(stride * 3 + RUNE_BATCH_ALIGNMENT / sizeof(double), 0.0);
+            uintptr_t base = ((uintptr_t)columns_storage.data() + RUNE_BATCH_ALIGNMENT - 1) &
+                             ~(uintptr_t)(RUNE_BATCH_ALIGNMENT - 1);
+            for (uint32_t c = 0; c < 3; ++c) {
+                columns[c] = (double*)base + c * stride;
+            }
+            for (uint32_t i = 0; i < BATCH_ROWS; ++i) {
+                ((double*)columns[0])[i] = (double)i;
+                ((double*)columns[1])[i] = 0.5 * (double)i;
+            }
+            batch = BatchContext{columns, 3, fx.ctx->get()};
+        },
+        []() { return fx.node && fx.node->vtbl->execute_batch(fx.inst, &batch, BATCH_ROWS); },
+        []() { fx.release(); }});
+
+    // Array Sum below and above the parallel_for threshold
+    const uint64_t sizes[] = {4096, 1u << 20};
+    for (uint64_t size : sizes) {
+        out.push_back(Benchmark{
+            "math.array_sum/" + std::to_string(size), size > 4096 ? (uint64_t)200 : 0,
+            [&host, size]() {
+                BufferView view;
+                if (fx.bind(host, "com.rune.example.math.array_sum") &&
+                    host.services()->buffer_create(sizeof(double), size, &view)) {
+                    for (uint64_t i = 0; i < size; ++i) {
+                        ((double*)view.ptr)[i] = (double)(i & 0xFF);
+                    }
+                    fx.ctx->set_input_buffer("Values", view);
+                    host.services()->buffer_release(view.owner);
+                }
+            },
+            [&host]() {
+                bool ok = fx.node && fx.execute();
+                host.end_run();
+                return ok;
+            },
+            []() { fx.release(); }});
+    }
+}
+
+static void add_config_benchmarks(MockHost& host, std::vector<Benchmark>& out) {
+    static NodeFixture fx;
+
+    out.push_back(Benchmark{
+        "config.json_parse.execute", 0,
+        [&host]() {
+            if (fx.bind(host, "com.rune.example.config.json_parse")) {
+                fx.ctx->set_input_string("JSON", "{\"server\":{\"host\":\"localhost\",\"ports\":[80,443]},\"debug\":true}");
+                fx.ctx->set_input_string("Path", "server.ports[1]");
+            }
+        },
+        []() { return fx.node && fx.execute(); },
+        []() { fx.release(); }});
+
+    // Alternating documents defeat the instance cache, so every run parses
+    out.push_back(Benchmark{
+        "config.json_parse.execute/changing", 0,
+        [&host]() {
+            if (fx.bind(host, "com.rune.example.config.json_parse")) {
+                fx.ctx->set_input_string("Path", "server.host");
+            }
+        },
+        []() {
+            static uint64_t n = 0;
+            fx.ctx->set_input_string("JSON", (n++ & 1) ? "{\"server\":{\"host\":\"a.example\"}}"
+                                                       : "{\"server\":{\"host\":\"b.example\"}}");
+            return fx.node && fx.execute();
+        },
+        []() { fx.release(); }});
+
+    out.push_back(Benchmark{
+        "config.csv_parse.execute", 0,
+        [&host]() {
+            if (fx.bind(host, "com.rune.example.config.csv_parse")) {
+                std::string csv = "id,name,score\n";
+                for (int i = 0; i < 64; ++i) {
+                    csv += std::to_string(i) + ",\"user " + std::to_string(i) + "\"," + std::to_string(i * 3) + "\n";
+                }
+                fx.ctx->set_input_string("CSV", csv);
+                fx.ctx->set_input_string("Delimiter", ",");
+            }
+        },
+        [&host]() {
+            bool ok = fx.node && fx.execute();
+            host.end_run();
+            return ok;
+        },
+        []() { fx.release(); }});
+
+    out.push_back(Benchmark{
+        "config.ini_get.execute", 0,
+        [&host]() {
+            if (fx.bind(host, "com.rune.example.config.ini_get")) {
+                fx.ctx->set_input_string("INI", "[general]\nname=rune\n\n[network]\nhost=localhost\nport=8080\n");
+                fx.ctx->set_input_string("Section", "network");
+                fx.ctx->set_input_string("Key", "port");
+            }
+        },
+        []() { return fx.node && fx.execute(); },
+        []() { fx.release(); }});
+}
+
+static void add_env_benchmarks(MockHost& host, std::vector<Benchmark>& out) {
+    static NodeFixture fx;
+
+    host.set_flow_env("API_URL", "https://api.example.com");
+    host.set_plugin_settings("com.rune.example.env", "{\"enabled\":true}");
+    host.set_rune_setting("cache_directory", "/tmp/rune/cache");
+
+    struct EnvCase {
+        const char* name;
+        const char* unique_name;
+        const char* input_pin;
+        const char* input;
+    };
+    static const EnvCase cases[] = {
+        {"env.get_env.execute", "com.rune.example.env.get_env", "Name", "API_URL"},
+        {"env.get_env.execute/missing", "com.rune.example.env.get_env", "Name", "NOT_SET"},
+        {"env.get_plugin_settings.execute", "com.rune.example.env.get_plugin_settings", "PluginID", "com.rune.example.env"},
+        {"env.get_rune_setting.execute", "com.rune.example.env.get_rune_setting", "Setting", "cache_directory"},
+    };
+    for (const EnvCase& c : cases) {
+        out.push_back(Benchmark{
+            c.name, 0,
+            [&host, &c]() {
+                if (fx.bind(host, c.unique_name)) {
+                    fx.ctx->set_input_string(c.input_pin, c.input);
+                }
+            },
+            []() { return fx.node && fx.execute(); },
+            []() { fx.release(); }});
+    }
+}
+
+static void add_timer_benchmarks(MockHost& host, std::vector<Benchmark>& out) {
+    static NodeFixture fx;
+
+    // Arm + cancel of a periodic timer
+    out.push_back(Benchmark{
+        "timer.event.start_stop_listening", 0,
+        [&host]() {
+            if (fx.bind(host, "com.rune.example.timer.event")) {
+                fx.ctx->set_property("IntervalMs", "16");
+            }
+        },
+        []() {
+            if (!fx.node || !fx.node->vtbl->start_listening(fx.inst, fx.ctx->get())) {
+                return false;
+            }
+            fx.node->vtbl->stop_listening(fx.inst);
+            return true;
+        },
+        []() { fx.release(); }});
+
+    // One tick delivered through the timer callback
+    out.push_back(Benchmark{
+        "timer.event.tick", 0,
+        [&host]() {
+            if (fx.bind(host, "com.rune.example.timer.event")) {
+                fx.ctx->set_property("IntervalMs", "16");
+                fx.node->vtbl->start_listening(fx.inst, fx.ctx->get());
+            }
+        },
+        [&host]() {
+            host.fire_timers();
+            return fx.node != nullptr;
+        },
+        []() {
+            if (fx.node) {
+                fx.node->vtbl->stop_listening(fx.inst);
+            }
+            fx.release();
+        }});
+
+    // Arm a one-shot delay and let it fire
+    out.push_back(Benchmark{
+        "timer.delay.execute_fire", 0,
+        [&host]() {
+            if (fx.bind(host, "com.rune.example.timer.delay")) {
+                fx.ctx->set_input_int("DelayMs", 5);
+            }
+        },
+        [&host]() {
+            if (!fx.node || !fx.execute()) {
+                return false;
+            }
+            host.fire_timers();
+            return fx.ctx->trigger_count("OnComplete") > 0;
+        },
+        []() { fx.release(); }});
+
+    // Node state snapshot into the shared writer, and restoring it in place
+    static MockSerializeWriter writer;
+    out.push_back(Benchmark{
+        "timer.event.serialize_to", 0,
+        [&host]() { fx.bind(host, "com.rune.example.timer.event"); },
+        []() {
+            writer.clear();
+            return fx.node && fx.node->vtbl->serialize_to &&
+                   fx.node->vtbl->serialize_to(fx.inst, writer.get());
+        },
+        []() { fx.release(); }});
+
+    out.push_back(Benchmark{
+        "timer.event.deserialize_from", 0,
+        [&host]() {
+            writer.clear();
+            if (fx.bind(host, "com.rune.example.timer.event") && fx.node->vtbl->serialize_to) {
+                fx.node->vtbl->serialize_to(fx.inst, writer.get());
+            }
+        },
+        []() {
+            return fx.node && fx.node->vtbl->deserialize_from &&
+                   fx.node->vtbl->deserialize_from(fx.inst, writer.data(), writer.size());
+        },
+        []() { fx.release(); }});
+
+    // Forking a flow: copy-on-write clone vs. eager create + state round trip
+    out.push_back(Benchmark{
+        "timer.event.fork/clone", 0,
+        [&host]() { fx.bind(host, "com.rune.example.timer.event"); },
+        []() {
+            void* copy = fx.node && fx.node->vtbl->clone_instance ? fx.node->vtbl->clone_instance(fx.inst) : nullptr;
+            if (copy) {
+                fx.node->vtbl->destroy_instance(copy);
+            }
+            return copy != nullptr;
+        },
+        []() { fx.release(); }});
+
+    out.push_back(Benchmark{
+        "timer.event.fork/serialize", 0,
+        [&host]() { fx.bind(host, "com.rune.example.timer.event"); },
+        []() {
+            if (!fx.node || !fx.node->vtbl->serialize_to) {
+                return false;
+            }
+            void* copy = fx.node->vtbl->create_instance();
+            writer.clear();
+            bool ok = copy && fx.node->vtbl->serialize_to(fx.inst, writer.get()) &&
+                      fx.node->vtbl->deserialize_from(copy, writer.data(), writer.size());
+            if (copy) {
+                fx.node->vtbl->destroy_instance(copy);
+            }
+            return ok;
+        },
+        []() { fx.release(); }});
+
+    // Hot reload of a running timer: swap the vtable, then migrate the
+    // listening instance onto it (here the "new" build is the same code)
+    out.push_back(Benchmark{
+        "timer.event.hot_reload", 0,
+        [&host]() {
+            if (fx.bind(host, "com.rune.example.timer.event")) {
+                fx.ctx->set_property("IntervalMs", "16");
+                fx.node->vtbl->start_listening(fx.inst, fx.ctx->get());
+            }
+        },
+        [&host]() {
+            if (!fx.node || !host.registry()->replace_node(fx.node->id, fx.node->desc, fx.node->vtbl)) {
+                return false;
+            }
+            fx.inst = host.migrate_instance(fx.node->id, fx.node->vtbl, fx.inst, fx.ctx->get());
+            return fx.inst != nullptr;
+        },
+        []() {
+            if (fx.node && fx.inst) {
+                fx.node->vtbl->stop_listening(fx.inst);
+            }
+            fx.release();
+        }});
+}
+
+// Plugin-side cost of a settings change: raw JSON vs. a pre-parsed view
+static void add_settings_benchmarks(MockHost& host, const std::vector<PluginLibrary*>& plugins,
+                                    std::vector<Benchmark>& out) {
+    static const char* SETTINGS_JSON =
+        "{\"enabled\":true,\"log_level\":\"debug\",\"max_items\":250,\"api_key\":\"\"}";
+
+    const PluginAPI* config = nullptr;
+    for (const PluginLibrary* plugin : plugins) {
+        if (std::strcmp(plugin->api()->info.id, "com.rune.example.config") == 0) {
+            config = plugin->api();
+        }
+    }
+    if (!config || !config->on_settings_changed) {
+        return;
+    }
+
+    out.push_back(Benchmark{
+        "config.on_settings_changed/json", 0, nullptr,
+        [config]() {
+            config->on_settings_changed(SETTINGS_JSON);
+            return true;
+        },
+        nullptr});
+
+    if (!config->on_settings_view_changed) {
+        return;
+    }
+    out.push_back(Benchmark{
+        "config.on_settings_changed/view", 0,
+        [&host, config]() { host.apply_settings(config, SETTINGS_JSON); },
+        [&host, config]() {
+            config->on_settings_view_changed(host.services()->get_settings_view(config->info.id));
+            return true;
+        },
+        nullptr});
+}
+
+static void add_log_benchmarks(MockHost& host, std::vector<Benchmark>& out) {
+    // DEBUG messages at the default WARN level: the cost of a dropped message
+    HostServices* services = host.services();
+    out.push_back(Benchmark{
+        "log.log_formatted/filtered", 0, nullptr,
+        [services]() {
+            services->log_formatted(LOG_LEVEL_DEBUG, "Delay started: %lld ms", (long long)1000);
+            return true;
+        },
+        nullptr});
+    out.push_back(Benchmark{
+        "log.RUNE_LOG_DEBUG/filtered", 0, nullptr,
+        [services]() {
+            RUNE_LOG_DEBUG(services, "Delay started: %lld ms", (long long)1000);
+            return true;
+        },
+        nullptr});
+}
+
+/* ==========================================================================
+ * Main
+ * ========================================================================== */
+
+static bool parse_options(int argc, char** argv, Options* options) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            options->iterations = std::strtoull(argv[++i], nullptr, 10);
+            if (options->iterations == 0) {
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options->filter = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, &options)) {
+        std::fprintf(stderr, "usage: %s [--iterations N] [--filter SUBSTRING]\n", argv[0]);
+        return 2;
+    }
+
+    MockHost host;
+
+    const char* plugin_paths[] = {
+        RUNE_BENCH_MATH_PLUGIN,
+        RUNE_BENCH_CONFIG_PLUGIN,
+        RUNE_BENCH_ENV_PLUGIN,
+        RUNE_BENCH_TIMER_PLUGIN,
+    };
+    std::vector<PluginLibrary*> plugins;
+    for (const char* path : plugin_paths) {
+        PluginLibrary* plugin = new PluginLibrary;
+        std::string error;
+        if (!plugin->open(path, &error)) {
+            std::fprintf(stderr, "failed to load plugin: %s\n", error.c_str());
+            return 1;
+        }
+        const PluginAPI* api = plugin->api();
+        if (!api->on_load(host.services())) {
+            std::fprintf(stderr, "%s: on_load failed\n", api->info.id);
+            return 1;
+        }
+        api->on_register(host.registry(), host.luau());
+        plugins.push_back(plugin);
+    }
+
+    std::vector<Benchmark> benchmarks;
+    add_math_benchmarks(host, benchmarks);
+    add_config_benchmarks(host, benchmarks);
+    add_env_benchmarks(host, benchmarks);
+    add_timer_benchmarks(host, benchmarks);
+    add_settings_benchmarks(host, plugins, benchmarks);
+    add_log_benchmarks(host, benchmarks);
+
+    std::printf("%-40s %12s %14s %10s %10s\n", "benchmark", "ns/op", "ops/s", "host/op", "heap/op");
+    int failures = 0;
+    for (const Benchmark& bench : benchmarks) {
+        failures += run_benchmark(host, bench, options);
+    }
+
+    for (size_t i = plugins.size(); i-- > 0;) {
+        plugins[i]->api()->on_unload();
+        delete plugins[i];
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,445 @@
+/**
+ * RUNE Plugin SDK - rune_coro.h tests (C++20)
+ *
+ * Drives a node built with rune::async_node_vtable through a MockHost whose
+ * timers and jobs are replaced by real threads, so waits complete on other
+ * threads while the test destroys instances mid-wait, as a host can. The
+ * threaded services keep the host contracts rune_coro.h relies on:
+ * destroy_timer waits for a running callback, and cancelled jobs still get
+ * their completion callback.
+ *
+ * Usage: rune_coro_test (exit status 0 on success)
+ */
+
+#include "mock_host.h"
+#include "rune_coro.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+using rune::mock::MockExecContext;
+using rune::mock::MockHost;
+
+using Clock = std::chrono::steady_clock;
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,    \
+                         __LINE__, #cond);                                  \
+            g_failures++;                                                   \
+        }                                                                   \
+    } while (0)
+
+/* ==========================================================================
+ * Threaded timers and jobs
+ * ========================================================================== */
+
+class ThreadedServices {
+public:
+    ThreadedServices() : timer_thread_([this] { run_timers(); }), job_thread_([this] { run_jobs(); }) {}
+
+    ~ThreadedServices() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        timer_thread_.join();
+        job_thread_.join();
+    }
+
+    static ThreadedServices* instance;
+
+    /* Replace the timer and job services of a host */
+    void install(HostServices* host) {
+        instance = this;
+        host->submit_job = &ThreadedServices::submit_job;
+        host->cancel_job = &ThreadedServices::cancel_job;
+        if (host->api_version >= 2) {
+            host->create_timer_ex = &ThreadedServices::create_timer_ex;
+            host->destroy_timer = &ThreadedServices::destroy_timer;
+            host->wait_job = &ThreadedServices::wait_job;
+        }
+    }
+
+    size_t pending_timers() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return timers_.size();
+    }
+
+private:
+    struct Timer {
+        Clock::time_point due;
+        TimerCallback     callback;
+        void*             user_data;
+    };
+
+    struct Job {
+        uint64_t              id;
+        JobFunction           fn;
+        void*                 user_data;
+        JobCompletionCallback on_complete;
+        bool                  cancelled;
+    };
+
+    static uint64_t create_timer_ex(const TimerDesc* desc) {
+        ThreadedServices* self = instance;
+        std::lock_guard<std::mutex> lock(self->mutex_);
+        uint64_t id = self->next_id_++;
+        self->timers_[id] = Timer{Clock::now() + std::chrono::microseconds(desc->interval_us),
+                                  desc->callback, desc->user_data};
+        self->cv_.notify_all();
+        return id;
+    }
+
+    /* Once this returns the callback is neither running nor will run */
+    static void destroy_timer(uint64_t id) {
+        ThreadedServices* self = instance;
+        std::unique_lock<std::mutex> lock(self->mutex_);
+        self->timers_.erase(id);
+        if (std::this_thread::get_id() != self->timer_thread_.get_id()) {
+            self->cv_.wait(lock, [&] { return self->firing_ != id; });
+        }
+    }
+
+    static JobHandle submit_job(JobFunction fn, void* user_data, JobCompletionCallback on_complete) {
+        ThreadedServices* self = instance;
+        std::lock_guard<std::mutex> lock(self->mutex_);
+        uint64_t id = self->next_id_++;
+        self->jobs_.push_back(Job{id, fn, user_data, on_complete, false});
+        self->cv_.notify_all();
+        return JobHandle{id};
+    }
+
+    /* Queued jobs are skipped but still completed (with success = false) */
+    static void cancel_job(JobHandle handle) {
+        ThreadedServices* self = instance;
+        std::lock_guard<std::mutex> lock(self->mutex_);
+        for (Job& job : self->jobs_) {
+            if (job.id == handle.id) {
+                job.cancelled = true;
+            }
+        }
+    }
+
+    static bool wait_job(JobHandle handle, uint32_t timeout_ms) {
+        (void)timeout_ms;
+        ThreadedServices* self = instance;
+        std::unique_lock<std::mutex> lock(self->mutex_);
+        self->cv_.wait(lock, [&] { return !self->queued(handle.id); });
+        return true;
+    }
+
+    bool queued(uint64_t id) const {
+        if (running_job_ == id) {
+            return true;
+        }
+        for (const Job& job : jobs_) {
+            if (job.id == id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run_timers() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            auto next = timers_.end();
+            for (auto it = timers_.begin(); it != timers_.end(); ++it) {
+                if (next == timers_.end() || it->second.due < next->second.due) {
+                    next = it;
+                }
+            }
+            if (next == timers_.end()) {
+                cv_.wait(lock);
+                continue;
+            }
+            if (next->second.due > Clock::now()) {
+                Clock::time_point due = next->second.due;  // The entry may be erased while waiting
+                cv_.wait_until(lock, due);
+                continue;
+            }
+            uint64_t id = next->first;
+            Timer timer = next->second;
+            timers_.erase(next);  // One-shot
+            firing_ = id;
+            lock.unlock();
+            timer.callback(timer.user_data);
+            lock.lock();
+            firing_ = 0;
+            cv_.notify_all();
+        }
+    }
+
+    void run_jobs() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            if (jobs_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            Job job = jobs_.front();
+            jobs_.pop_front();
+            running_job_ = job.id;
+            lock.unlock();
+            if (!job.cancelled) {
+                job.fn(job.user_data);
+            }
+            if (job.on_complete) {
+                job.on_complete(job.user_data, !job.cancelled);
+            }
+            lock.lock();
+            running_job_ = 0;
+            cv_.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<uint64_t, Timer> timers_;
+    std::deque<Job> jobs_;
+    uint64_t next_id_ = 1;
+    uint64_t firing_ = 0;
+    uint64_t running_job_ = 0;
+    bool stopping_ = false;
+    std::thread timer_thread_;
+    std::thread job_thread_;
+};
+
+ThreadedServices* ThreadedServices::instance = nullptr;
+
+/* ==========================================================================
+ * Test node
+ *
+ * Properties: Steps (waits to run), Ms (length of each), Job ("1" to wait
+ * on jobs that sleep instead of on timers).
+ * ========================================================================== */
+
+static std::atomic<int> g_resumed(0);
+static std::atomic<int> g_finished(0);
+static std::atomic<int> g_job_runs(0);
+static std::atomic<int> g_signals(0);
+
+static void count_signal(ExecContext* ctx, bool success) {
+    (void)ctx;
+    (void)success;
+    g_signals++;
+}
+
+static int int_property(ExecContext* ctx, const char* name) {
+    const char* value = ctx->get_property(ctx, name);
+    return value ? std::atoi(value) : 0;
+}
+
+static rune::AsyncTask wait_body(rune::AsyncScope& scope) {
+    ExecContext* ctx = scope.ctx();
+    const int steps = int_property(ctx, "Steps");
+    const uint32_t ms = (uint32_t)int_property(ctx, "Ms");
+    const bool use_job = int_property(ctx, "Job") != 0;
+
+    for (int i = 0; i < steps; ++i) {
+        bool ok;
+        if (use_job) {
+            ok = co_await scope.job([ms] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+                g_job_runs++;
+            });
+        } else {
+            ok = co_await scope.sleep(ms);
+        }
+        if (!ok) {
+            co_return false;
+        }
+        g_resumed++;
+    }
+    g_finished++;
+    co_return true;
+}
+
+static const NodeVTable wait_vtable = rune::async_node_vtable<wait_body>();
+
+static const NodeDesc wait_desc = {
+    "Wait", "Test", "com.rune.test.coro.wait", nullptr, 0,
+    NODE_FLAG_ASYNC | NODE_FLAG_SIGNALS_COMPLETION, nullptr, nullptr, nullptr
+};
+
+static void reset_counters() {
+    g_resumed = 0;
+    g_finished = 0;
+    g_job_runs = 0;
+    g_signals = 0;
+}
+
+struct Run {
+    MockExecContext ctx;
+    void* inst;
+
+    Run(MockHost& host, int steps, int ms, bool job) : ctx(host, &wait_desc), inst(wait_vtable.create_instance()) {
+        ctx.set_property("Steps", std::to_string(steps));
+        ctx.set_property("Ms", std::to_string(ms));
+        ctx.set_property("Job", job ? "1" : "0");
+        ctx.get()->signal_complete = count_signal;
+    }
+    ~Run() { destroy(); }
+
+    bool execute() { return wait_vtable.execute(inst, ctx.get()); }
+
+    /* Until the body has finished and signalled completion the n-th time */
+    bool wait_complete(int signals, int timeout_ms) {
+        auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (!wait_vtable.is_complete(inst) || g_signals < signals) {
+            if (Clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    void destroy() {
+        if (inst) {
+            wait_vtable.destroy_instance(inst);
+            inst = nullptr;
+        }
+    }
+};
+
+static double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/* ==========================================================================
+ * Tests
+ * ========================================================================== */
+
+static void test_waits_complete(MockHost& host) {
+    for (bool job : {false, true}) {
+        reset_counters();
+        Run run(host, 3, 2, job);
+        CHECK(run.execute());
+        CHECK(run.wait_complete(1, 2000));
+        CHECK(g_resumed == 3);
+        CHECK(g_finished == 1);
+        CHECK(g_job_runs == (job ? 3 : 0));
+
+        // A finished body is replaced by the next execute
+        CHECK(run.execute());
+        CHECK(run.wait_complete(2, 2000));
+        CHECK(g_finished == 2);
+    }
+}
+
+static void test_destroy_mid_sleep(MockHost& host, ThreadedServices& threads) {
+    reset_counters();
+    Clock::time_point start = Clock::now();
+    {
+        Run run(host, 1, 10000, false);
+        CHECK(run.execute());
+        CHECK(!wait_vtable.is_complete(run.inst));
+    }
+    CHECK(elapsed_ms(start) < 1000.0);
+    CHECK(threads.pending_timers() == 0);
+    CHECK(g_resumed == 0);
+}
+
+static void test_destroy_mid_job(MockHost& host) {
+    reset_counters();
+    {
+        Run run(host, 1, 50, true);
+        CHECK(run.execute());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));  // Job is running
+    }
+    // Destroy waited for the running job, and the body was not resumed
+    CHECK(g_job_runs == 1);
+    CHECK(g_resumed == 0);
+}
+
+/* Destroy at arbitrary points while waits complete on the other threads */
+static void test_destroy_races(MockHost& host) {
+    reset_counters();
+    std::mt19937 rng(12345);
+    for (int i = 0; i < 400; ++i) {
+        Run run(host, 4, 1, (i & 1) != 0);
+        CHECK(run.execute());
+        std::this_thread::sleep_for(std::chrono::microseconds(rng() % 4000));
+    }
+}
+
+static void test_shutdown_with_live_frames(MockHost& host) {
+    // Pools must outlive the frames allocated from them
+    reset_counters();
+    {
+        Run run(host, 1, 10000, false);
+        CHECK(run.execute());
+        CHECK(!rune::coro_shutdown());
+        rune::coro_init(host.services());
+    }
+    CHECK(g_resumed == 0);
+}
+
+static void test_legacy_host(ThreadedServices& threads) {
+    // Version 1 hosts have no create_timer_ex, so sleeps run on the job system
+    MockHost host(1);
+    rune::coro_init(host.services());
+    threads.install(host.services());
+
+    reset_counters();
+    {
+        Run run(host, 2, 2, false);
+        CHECK(run.execute());
+        CHECK(run.wait_complete(0, 2000));  // Version 1 hosts poll is_complete
+        CHECK(g_resumed == 2);
+    }
+
+    reset_counters();
+    Clock::time_point start = Clock::now();
+    {
+        Run run(host, 1, 10000, false);
+        CHECK(run.execute());
+    }
+    CHECK(elapsed_ms(start) < 1000.0);
+    CHECK(g_resumed == 0);
+
+    CHECK(rune::coro_shutdown());
+}
+
+int main() {
+    {
+        ThreadedServices threads;
+        {
+            MockHost host;
+            rune::coro_init(host.services());
+            threads.install(host.services());
+
+            test_waits_complete(host);
+            test_destroy_mid_sleep(host, threads);
+            test_destroy_mid_job(host);
+            test_destroy_races(host);
+            test_shutdown_with_live_frames(host);
+
+            CHECK(rune::coro_shutdown());
+            MockHost::Counters counters = host.counters();
+            CHECK(counters.allocs == counters.frees);
+        }
+        test_legacy_host(threads);
+    }
+
+    if (g_failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("rune_coro_test: all checks passed\n");
+    return 0;
+}
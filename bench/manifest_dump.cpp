@@ -0,0 +1,135 @@
+/**
+ * RUNE Plugin SDK - Manifest node catalog generator
+ *
+ * Loads a plugin into a MockHost, runs on_load and on_register, and prints
+ * the registered node types as the "nodes" array of a plugin.json manifest
+ * (schema documented in plugin_api.h). Paste the output into plugin.json, or
+ * diff it against the checked-in manifest to catch drift after changing a
+ * NodeDesc.
+ *
+ * Usage: rune_manifest_dump PLUGIN_LIBRARY
+ */
+
+#include "mock_host.h"
+
+#include <cstdio>
+#include <string>
+
+using rune::mock::MockHost;
+using rune::mock::PluginLibrary;
+
+static const struct {
+    uint32_t    bit;
+    const char* name;
+} NODE_FLAG_NAMES[] = {
+    {NODE_FLAG_TRIGGER_EVENT, "trigger_event"},
+    {NODE_FLAG_PURE_DATA, "pure_data"},
+    {NODE_FLAG_ASYNC, "async"},
+    {NODE_FLAG_STATEFUL, "stateful"},
+    {NODE_FLAG_HIDDEN, "hidden"},
+    {NODE_FLAG_MEMOIZABLE, "memoizable"},
+    {NODE_FLAG_REPORTS_CHANGES, "reports_changes"},
+    {NODE_FLAG_SIGNALS_COMPLETION, "signals_completion"},
+    {NODE_FLAG_STATELESS, "stateless"},
+    {NODE_FLAG_THREAD_SAFE, "thread_safe"},
+    {NODE_FLAG_MAIN_THREAD_ONLY, "main_thread_only"},
+    {NODE_FLAG_IO_BOUND, "io_bound"},
+};
+
+static const struct {
+    uint32_t    bit;
+    const char* name;
+} PIN_FLAG_NAMES[] = {
+    {PIN_FLAG_OPTIONAL, "optional"},
+    {PIN_FLAG_MULTI_CONNECT, "multi_connect"},
+    {PIN_FLAG_HIDDEN, "hidden"},
+};
+
+static std::string quote(const char* s) {
+    std::string out = "\"";
+    for (; s && *s; ++s) {
+        if (*s == '"' || *s == '\\') {
+            out += '\\';
+        }
+        out += *s;
+    }
+    return out + "\"";
+}
+
+template <typename Names, size_t N>
+static std::string flag_list(uint32_t flags, const Names (&names)[N]) {
+    std::string out = "[";
+    for (size_t i = 0; i < N; ++i) {
+        if (flags & names[i].bit) {
+            out += (out.size() > 1 ? ", " : "") + quote(names[i].name);
+            flags &= ~names[i].bit;
+        }
+    }
+    if (flags) {
+        std::fprintf(stderr, "warning: unnamed flag bits 0x%x\n", flags);
+    }
+    return out + "]";
+}
+
+static void print_node(const NodeDesc* desc, bool last) {
+    std::printf("        {\n");
+    std::printf("            \"unique_name\": %s,\n", quote(desc->unique_name).c_str());
+    std::printf("            \"name\": %s,\n", quote(desc->name).c_str());
+    std::printf("            \"category\": %s,\n", quote(desc->category).c_str());
+    if (desc->description) {
+        std::printf("            \"description\": %s,\n", quote(desc->description).c_str());
+    }
+    if (desc->icon) {
+        std::printf("            \"icon\": %s,\n", quote(desc->icon).c_str());
+    }
+    if (desc->color) {
+        std::printf("            \"color\": [%d, %d, %d],\n", desc->color[0], desc->color[1], desc->color[2]);
+    }
+    std::printf("            \"flags\": %s,\n", flag_list(desc->flags, NODE_FLAG_NAMES).c_str());
+    std::printf("            \"pins\": [\n");
+    for (uint32_t i = 0; i < desc->pin_count; ++i) {
+        const PinDesc& pin = desc->pins[i];
+        std::printf("                { \"name\": %s, \"type\": %s, \"direction\": \"%s\"",
+                    quote(pin.name).c_str(), quote(pin.type).c_str(), pin.direction == PIN_OUT ? "out" : "in");
+        if (pin.kind == PIN_KIND_EXECUTION) {
+            std::printf(", \"kind\": \"execution\"");
+        }
+        if (pin.flags) {
+            std::printf(", \"flags\": %s", flag_list(pin.flags, PIN_FLAG_NAMES).c_str());
+        }
+        std::printf(" }%s\n", i + 1 < desc->pin_count ? "," : "");
+    }
+    std::printf("            ]\n");
+    std::printf("        }%s\n", last ? "" : ",");
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s PLUGIN_LIBRARY\n", argv[0]);
+        return 2;
+    }
+
+    MockHost host;
+    PluginLibrary plugin;
+    std::string error;
+    if (!plugin.open(argv[1], &error)) {
+        std::fprintf(stderr, "failed to load plugin: %s\n", error.c_str());
+        return 1;
+    }
+    const PluginAPI* api = plugin.api();
+    if (!api->on_load(host.services())) {
+        std::fprintf(stderr, "%s: on_load failed\n", api->info.id);
+        return 1;
+    }
+    api->on_register(host.registry(), host.luau());
+
+    const std::vector<MockHost::RegisteredNode>& nodes = host.nodes();
+    std::printf("    \"nodes\": [\n");
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        print_node(nodes[i].desc, i + 1 == nodes.size());
+    }
+    std::printf("    ]\n");
+
+    api->on_unload();
+    return 0;
+}
@@ -0,0 +1,1757 @@
+/**
+ * RUNE Plugin SDK - Mock Host implementation
+ */
+
+#include "mock_host.h"
+
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32) || defined(_WIN64)
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
+/* ==========================================================================
+ * Opaque host types
+ * ========================================================================== */
+
+struct BufferOwner {
+    uint32_t refs;
+    void*    mem;
+};
+
+struct ObjectPool {
+    uint32_t object_size;
+    uint32_t align;
+    uint32_t live;
+};
+
+struct JsonDoc {
+    std::string source;
+    std::deque<std::string> results;  /* Query results, stable until close */
+};
+
+struct JsonPath {
+    /* Keys, or "[n]" entries for array indices */
+    std::vector<std::string> segments;
+};
+
+struct CsvReader {
+    const char* data;
+    size_t len;
+    size_t pos;
+    char delimiter;
+    std::string mapped;  /* Owns the file contents for the *_mapped variant */
+    std::vector<StringView> cells;
+    std::vector<uint32_t> row_offsets;
+};
+
+struct SettingsView {
+    struct Value {
+        SettingsFieldType type;
+        bool        b;
+        int64_t     i;
+        double      f;
+        std::string s;
+    };
+    std::vector<Value> values;  /* Indexed by field ID */
+};
+
+struct IniDoc {
+    struct Entry {
+        std::string key;
+        std::string value;
+    };
+    struct Section {
+        std::string name;
+        std::vector<Entry> entries;
+    };
+    std::vector<Section> sections;  /* Section "" holds keys before the first header */
+};
+
+namespace rune {
+namespace mock {
+
+static MockHost* g_current = nullptr;
+
+MockHost* MockHost::current() {
+    return g_current;
+}
+
+/* ==========================================================================
+ * Parsing helpers (deliberately simple reference implementations)
+ * ========================================================================== */
+
+static const char* skip_ws(const char* p, const char* end) {
+    while (p < end && std::isspace((unsigned char)*p)) {
+        ++p;
+    }
+    return p;
+}
+
+static const char* skip_json_string(const char* p, const char* end) {
+    ++p;  /* Opening quote */
+    while (p < end && *p != '"') {
+        p += (*p == '\\') ? 2 : 1;
+    }
+    return p < end ? p + 1 : nullptr;
+}
+
+/* Returns the end of the JSON value starting at p, or nullptr if malformed */
+static const char* skip_json_value(const char* p, const char* end) {
+    p = skip_ws(p, end);
+    if (p >= end) {
+        return nullptr;
+    }
+    if (*p == '"') {
+        return skip_json_string(p, end);
+    }
+    if (*p == '{' || *p == '[') {
+        const char close = (*p == '{') ? '}' : ']';
+        const bool object = (*p == '{');
+        p = skip_ws(p + 1, end);
+        if (p < end && *p == close) {
+            return p + 1;
+        }
+        while (p < end) {
+            if (object) {
+                p = skip_ws(p, end);
+                if (p >= end || *p != '"' || !(p = skip_json_string(p, end))) {
+                    return nullptr;
+                }
+                p = skip_ws(p, end);
+                if (p >= end || *p != ':') {
+                    return nullptr;
+                }
+                ++p;
+            }
+            if (!(p = skip_json_value(p, end))) {
+                return nullptr;
+            }
+            p = skip_ws(p, end);
+            if (p < end && *p == ',') {
+                ++p;
+                continue;
+            }
+            return (p < end && *p == close) ? p + 1 : nullptr;
+        }
+        return nullptr;
+    }
+    const char* start = p;
+    while (p < end && (std::isalnum((unsigned char)*p) || *p == '-' || *p == '+' || *p == '.')) {
+        ++p;
+    }
+    return p > start ? p : nullptr;
+}
+
+static bool json_valid(const char* p, const char* end) {
+    const char* value_end = skip_json_value(p, end);
+    return value_end && skip_ws(value_end, end) == end;
+}
+
+static bool compile_json_path(const char* path, JsonPath* out) {
+    const char* p = path ? path : "";
+    if (p[0] == '$') {
+        ++p;
+    }
+    std::string segment;
+    for (; *p; ++p) {
+        if (*p == '.') {
+            if (!segment.empty()) {
+                out->segments.push_back(segment);
+            }
+            segment.clear();
+        } else if (*p == '[') {
+            if (!segment.empty()) {
+                out->segments.push_back(segment);
+            }
+            segment = "[";
+            while (*++p && *p != ']') {
+                if (!std::isdigit((unsigned char)*p)) {
+                    return false;
+                }
+                segment += *p;
+            }
+            if (!*p) {
+                return false;
+            }
+            out->segments.push_back(segment);
+            segment.clear();
+        } else {
+            segment += *p;
+        }
+    }
+    if (!segment.empty()) {
+        out->segments.push_back(segment);
+    }
+    return true;
+}
+
+/* Finds the value addressed by path; strings are returned without quotes */
+static bool query_json(const std::string& doc, const JsonPath& path, std::string* out) {
+    const char* p = doc.data();
+    const char* end = p + doc.size();
+
+    for (const std::string& segment : path.segments) {
+        p = skip_ws(p, end);
+        if (segment[0] == '[') {
+            if (p >= end || *p != '[') {
+                return false;
+            }
+            long index = std::strtol(segment.c_str() + 1, nullptr, 10);
+            p = skip_ws(p + 1, end);
+            for (long i = 0; i < index; ++i) {
+                if (!(p = skip_json_value(p, end))) {
+                    return false;
+                }
+                p = skip_ws(p, end);
+                if (p >= end || *p != ',') {
+                    return false;
+                }
+                p = skip_ws(p + 1, end);
+            }
+            if (p >= end || *p == ']') {
+                return false;
+            }
+            continue;
+        }
+
+        if (p >= end || *p != '{') {
+            return false;
+        }
+        p = skip_ws(p + 1, end);
+        bool found = false;
+        while (p < end && *p == '"') {
+            const char* key_end = skip_json_string(p, end);
+            if (!key_end) {
+                return false;
+            }
+            bool match = (size_t)(key_end - p - 2) == segment.size() &&
+                         std::memcmp(p + 1, segment.data(), segment.size()) == 0;
+            p = skip_ws(key_end, end);
+            if (p >= end || *p != ':') {
+                return false;
+            }
+            p = skip_ws(p + 1, end);
+            if (match) {
+                found = true;
+                break;
+            }
+            if (!(p = skip_json_value(p, end))) {
+                return false;
+            }
+            p = skip_ws(p, end);
+            if (p < end && *p == ',') {
+                p = skip_ws(p + 1, end);
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+
+    p = skip_ws(p, end);
+    const char* value_end = skip_json_value(p, end);
+    if (!value_end) {
+        return false;
+    }
+    if (*p == '"') {
+        out->assign(p + 1, value_end - 1);
+    } else {
+        out->assign(p, value_end);
+    }
+    return true;
+}
+
+static bool read_file(const char* path, std::string* out) {
+    std::ifstream file(path ? path : "", std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    *out = contents.str();
+    return true;
+}
+
+static std::string trim(const char* begin, const char* end) {
+    while (begin < end && std::isspace((unsigned char)*begin)) {
+        ++begin;
+    }
+    while (end > begin && std::isspace((unsigned char)end[-1])) {
+        --end;
+    }
+    return std::string(begin, end);
+}
+
+static void parse_ini(const char* data, size_t len, IniDoc* doc) {
+    doc->sections.push_back(IniDoc::Section{std::string(), {}});
+    const char* p = data;
+    const char* end = data + len;
+    while (p < end) {
+        const char* line_end = (const char*)std::memchr(p, '\n', (size_t)(end - p));
+        if (!line_end) {
+            line_end = end;
+        }
+        std::string line = trim(p, line_end);
+        p = line_end + 1;
+
+        if (line.empty() || line[0] == ';' || line[0] == '#') {
+            continue;
+        }
+        if (line[0] == '[' && line.back() == ']') {
+            doc->sections.push_back(IniDoc::Section{line.substr(1, line.size() - 2), {}});
+            continue;
+        }
+        size_t eq = line.find('=');
+        if (eq != std::string::npos) {
+            doc->sections.back().entries.push_back(IniDoc::Entry{
+                trim(line.data(), line.data() + eq),
+                trim(line.data() + eq + 1, line.data() + line.size())});
+        }
+    }
+}
+
+static IniDoc::Section* find_section(const IniDoc* doc, const char* section) {
+    for (const IniDoc::Section& s : doc->sections) {
+        if (s.name == (section ? section : "")) {
+            return const_cast<IniDoc::Section*>(&s);
+        }
+    }
+    return nullptr;
+}
+
+/* Reads up to max_rows rows; cells exclude enclosing quotes */
+static bool csv_read_rows(CsvReader* reader, uint32_t max_rows, bool* escaped) {
+    reader->cells.clear();
+    reader->row_offsets.assign(1, 0);
+    *escaped = false;
+
+    const char* data = reader->data;
+    size_t& pos = reader->pos;
+    while (pos < reader->len && reader->row_offsets.size() <= max_rows) {
+        if (data[pos] == '\n' || data[pos] == '\r') {
+            ++pos;  /* Skip blank lines and CRLF remainders */
+            continue;
+        }
+        for (;;) {
+            StringView cell = {data + pos, 0};
+            if (pos < reader->len && data[pos] == '"') {
+                size_t start = ++pos;
+                while (pos < reader->len) {
+                    if (data[pos] == '"' && pos + 1 < reader->len && data[pos + 1] == '"') {
+                        *escaped = true;
+                        pos += 2;
+                    } else if (data[pos] == '"') {
+                        break;
+                    } else {
+                        ++pos;
+                    }
+                }
+                cell.ptr = data + start;
+                cell.len = pos - start;
+                pos = pos < reader->len ? pos + 1 : pos;
+                while (pos < reader->len && data[pos] != reader->delimiter &&
+                       data[pos] != '\n' && data[pos] != '\r') {
+                    ++pos;
+                }
+            } else {
+                size_t start = pos;
+                while (pos < reader->len && data[pos] != reader->delimiter &&
+                       data[pos] != '\n' && data[pos] != '\r') {
+                    ++pos;
+                }
+                cell.len = pos - start;
+            }
+            reader->cells.push_back(cell);
+            if (pos < reader->len && data[pos] == reader->delimiter) {
+                ++pos;
+                continue;
+            }
+            break;
+        }
+        reader->row_offsets.push_back((uint32_t)reader->cells.size());
+    }
+    return reader->row_offsets.size() > 1;
+}
+
+static void* aligned_malloc(size_t align, size_t size) {
+    size = (size + align - 1) / align * align;
+#if defined(_WIN32) || defined(_WIN64)
+    return _aligned_malloc(size ? size : align, align);
+#else
+    return std::aligned_alloc(align, size ? size : align);
+#endif
+}
+
+static void aligned_free(void* ptr) {
+#if defined(_WIN32) || defined(_WIN64)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+static char* copy_string(HostServices* services, const std::string& s) {
+    char* out = (char*)services->alloc(s.size() + 1);
+    if (out) {
+        std::memcpy(out, s.c_str(), s.size() + 1);
+    }
+    return out;
+}
+
+/* ==========================================================================
+ * HostServices / registry callbacks
+ * ========================================================================== */
+
+struct Services {
+    static MockHost& host() { return *g_current; }
+
+    static void count_alloc(size_t size) {
+        host().counters_.allocs++;
+        host().counters_.alloc_bytes += size;
+    }
+
+    static void count_free() {
+        host().counters_.frees++;
+    }
+
+    /* Logging */
+
+    static void log(PluginLogLevel level, const char* message) {
+        if (level >= host().log_level_) {
+            static const char* names[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+            std::fprintf(stderr, "[%s] %s\n", names[level & 3], message ? message : "");
+        }
+    }
+
+    /* Formats before filtering, as the host's log_formatted does */
+    static void log_formatted(PluginLogLevel level, const char* format, ...) {
+        char buffer[1024];
+        va_list args;
+        va_start(args, format);
+        std::vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        log(level, buffer);
+    }
+
+    static PluginLogLevel get_log_level(void) { return host().log_level_; }
+    static bool is_log_enabled(PluginLogLevel level) { return level >= host().log_level_; }
+
+    static uint32_t log_register_format(PluginLogLevel level, const char* format) {
+        if (!format) {
+            return 0;
+        }
+        host().log_formats_.push_back(MockHost::LogFormat{level, format});
+        return (uint32_t)host().log_formats_.size();
+    }
+
+    /* Formats immediately; the mock keeps no record buffer to defer into */
+    static void log_deferred(uint32_t format_id, ...) {
+        if (format_id == 0 || format_id > host().log_formats_.size()) {
+            return;
+        }
+        const MockHost::LogFormat& entry = host().log_formats_[format_id - 1];
+        host().deferred_logs_++;
+        if (entry.level < host().log_level_) {
+            return;
+        }
+        char buffer[1024];
+        va_list args;
+        va_start(args, format_id);
+        std::vsnprintf(buffer, sizeof(buffer), entry.format, args);
+        va_end(args);
+        log(entry.level, buffer);
+    }
+
+    /* Jobs - run inline on the calling thread */
+
+    static JobHandle next_job() {
+        JobHandle handle = {host().next_job_id_++};
+        return handle;
+    }
+
+    static JobHandle submit_job(JobFunction fn, void* user_data, JobCompletionCallback on_complete) {
+        if (fn) {
+            fn(user_data);
+        }
+        if (on_complete) {
+            on_complete(user_data, true);
+        }
+        return next_job();
+    }
+
+    static bool poll_job(JobHandle handle) { (void)handle; return true; }
+    static void cancel_job(JobHandle handle) { (void)handle; }
+
+    static JobHandle submit_job_ex(const JobDesc* job) {
+        return job ? submit_job(job->fn, job->user_data, job->on_complete) : JobHandle{0};
+    }
+
+    static JobHandle submit_job_group(const JobDesc* jobs, uint32_t count,
+                                      JobCompletionCallback on_group_complete, void* user_data) {
+        for (uint32_t i = 0; i < count; ++i) {
+            submit_job_ex(&jobs[i]);
+        }
+        if (on_group_complete) {
+            on_group_complete(user_data, true);
+        }
+        return next_job();
+    }
+
+    static JobHandle submit_job_after(const JobDesc* job, const JobHandle* deps, uint32_t dep_count) {
+        (void)deps;
+        (void)dep_count;
+        return submit_job_ex(job);
+    }
+
+    static bool parallel_for(uint64_t begin, uint64_t end, uint64_t grain,
+                             ParallelForFunction fn, void* user_data) {
+        if (!fn) {
+            return false;
+        }
+        if (grain == 0) {
+            grain = end - begin;
+        }
+        for (uint64_t chunk = begin; chunk < end; chunk += grain) {
+            fn(chunk, (end - chunk < grain) ? end : chunk + grain, user_data);
+        }
+        return true;
+    }
+
+    static uint32_t get_worker_count(void) { return 1; }
+    static bool wait_job(JobHandle handle, uint32_t timeout_ms) { (void)handle; (void)timeout_ms; return true; }
+
+    /* Paths and capabilities */
+
+    static const char* get_plugin_data_dir(const char* plugin_id) { (void)plugin_id; return "."; }
+    static const char* get_cache_dir(void) { return "."; }
+    static const char* get_flows_dir(void) { return "."; }
+    static bool has_capability(const char* capability) { (void)capability; return false; }
+
+    /* Memory */
+
+    static void* alloc(size_t size) {
+        count_alloc(size);
+        return std::malloc(size);
+    }
+
+    static void free(void* ptr) {
+        if (ptr) {
+            count_free();
+        }
+        std::free(ptr);
+    }
+
+    /* Timers - fired by MockHost::fire_timers */
+
+    static uint64_t add_timer(TimerCallback callback, void* user_data, bool one_shot) {
+        if (!callback) {
+            return 0;
+        }
+        uint64_t id = host().next_timer_id_++;
+        host().timers_[id] = MockHost::Timer{callback, user_data, one_shot};
+        return id;
+    }
+
+    static uint64_t create_timer(uint32_t interval_ms, void (*callback)(void*), void* user_data) {
+        (void)interval_ms;
+        return add_timer(callback, user_data, false);
+    }
+
+    static uint64_t create_timer_ex(const TimerDesc* desc) {
+        return desc ? add_timer(desc->callback, desc->user_data, desc->mode == TIMER_MODE_ONE_SHOT) : 0;
+    }
+
+    static void destroy_timer(uint64_t timer_id) {
+        host().timers_.erase(timer_id);
+    }
+
+    /* Legacy JSON */
+
+    static const char* json_parse(const char* json_str, const char* json_path) {
+        JsonPath path;
+        std::string source = json_str ? json_str : "";
+        if (!compile_json_path(json_path, &path) || !query_json(source, path, &host().scratch_)) {
+            return nullptr;
+        }
+        return host().scratch_.c_str();
+    }
+
+    static char* json_stringify(const char* json_obj) {
+        return copy_string(host().services(), json_obj ? json_obj : "null");
+    }
+
+    static bool json_validate(const char* json_str) {
+        return json_str && json_valid(json_str, json_str + std::strlen(json_str));
+    }
+
+    /* Legacy CSV */
+
+    static CsvData* csv_parse(const char* csv_str, char delimiter) {
+        CsvReader reader = {csv_str ? csv_str : "", csv_str ? std::strlen(csv_str) : 0, 0, delimiter,
+                            std::string(), {}, {}};
+        bool escaped;
+        csv_read_rows(&reader, UINT32_MAX, &escaped);
+
+        CsvData* data = (CsvData*)alloc(sizeof(CsvData));
+        data->row_count = (uint32_t)reader.row_offsets.size() - 1;
+        data->rows = (CsvRow*)alloc(sizeof(CsvRow) * (data->row_count ? data->row_count : 1));
+        for (uint32_t r = 0; r < data->row_count; ++r) {
+            CsvRow& row = data->rows[r];
+            row.count = reader.row_offsets[r + 1] - reader.row_offsets[r];
+            row.cells = (const char**)alloc(sizeof(char*) * (row.count ? row.count : 1));
+            for (uint32_t c = 0; c < row.count; ++c) {
+                const StringView& cell = reader.cells[reader.row_offsets[r] + c];
+                char* text = (char*)alloc(cell.len + 1);
+                rune_csv_unescape(cell, text, cell.len + 1);
+                row.cells[c] = text;
+            }
+        }
+        return data;
+    }
+
+    static void csv_free(CsvData* data) {
+        if (!data) {
+            return;
+        }
+        for (uint32_t r = 0; r < data->row_count; ++r) {
+            for (uint32_t c = 0; c < data->rows[r].count; ++c) {
+                free((void*)data->rows[r].cells[c]);
+            }
+            free((void*)data->rows[r].cells);
+        }
+        free(data->rows);
+        free(data);
+    }
+
+    static char* csv_stringify(const CsvData* data, char delimiter) {
+        std::string out;
+        for (uint32_t r = 0; data && r < data->row_count; ++r) {
+            for (uint32_t c = 0; c < data->rows[r].count; ++c) {
+                if (c) {
+                    out += delimiter;
+                }
+                out += data->rows[r].cells[c];
+            }
+            out += '\n';
+        }
+        return copy_string(host().services(), out);
+    }
+
+    /* Legacy INI */
+
+    static const char* ini_get(const char* ini_str, const char* section, const char* key) {
+        IniDoc doc;
+        parse_ini(ini_str ? ini_str : "", ini_str ? std::strlen(ini_str) : 0, &doc);
+        const char* value = ini_doc_get(&doc, section, key);
+        if (!value) {
+            return nullptr;
+        }
+        host().scratch_ = value;
+        return host().scratch_.c_str();
+    }
+
+    static char* ini_set(const char* ini_str, const char* section, const char* key, const char* value) {
+        IniDoc doc;
+        parse_ini(ini_str ? ini_str : "", ini_str ? std::strlen(ini_str) : 0, &doc);
+        ini_doc_set(&doc, section, key, value);
+        return ini_doc_serialize(&doc);
+    }
+
+    static char** string_array(const std::vector<std::string>& strings, uint32_t* count) {
+        *count = (uint32_t)strings.size();
+        char** out = (char**)alloc(sizeof(char*) * (strings.empty() ? 1 : strings.size()));
+        for (size_t i = 0; i < strings.size(); ++i) {
+            out[i] = copy_string(host().services(), strings[i]);
+        }
+        return out;
+    }
+
+    static char** ini_get_sections(const char* ini_str, uint32_t* count) {
+        IniDoc doc;
+        parse_ini(ini_str ? ini_str : "", ini_str ? std::strlen(ini_str) : 0, &doc);
+        std::vector<std::string> names;
+        for (size_t i = 1; i < doc.sections.size(); ++i) {
+            names.push_back(doc.sections[i].name);
+        }
+        return string_array(names, count);
+    }
+
+    static char** ini_get_keys(const char* ini_str, const char* section, uint32_t* count) {
+        IniDoc doc;
+        parse_ini(ini_str ? ini_str : "", ini_str ? std::strlen(ini_str) : 0, &doc);
+        std::vector<std::string> keys;
+        if (IniDoc::Section* s = find_section(&doc, section)) {
+            for (const IniDoc::Entry& e : s->entries) {
+                keys.push_back(e.key);
+            }
+        }
+        return string_array(keys, count);
+    }
+
+    static void ini_free_strings(char** strings, uint32_t count) {
+        for (uint32_t i = 0; strings && i < count; ++i) {
+            free(strings[i]);
+        }
+        free(strings);
+    }
+
+    /* Environment and settings */
+
+    static const char* lookup(const std::map<std::string, std::string>& map, const char* key) {
+        auto it = map.find(key ? key : "");
+        return it != map.end() ? it->second.c_str() : nullptr;
+    }
+
+    static const char* flow_env_get(const char* key) { return lookup(host().flow_env_, key); }
+    static bool flow_env_has(const char* key) { return lookup(host().flow_env_, key) != nullptr; }
+    static void flow_env_set(const char* key, const char* value) { host().set_flow_env(key, value ? value : ""); }
+    static bool flow_env_remove(const char* key) { host().flow_env_generation_++; return host().flow_env_.erase(key) != 0; }
+
+    static const char* app_env_get(const char* key) { return lookup(host().app_env_, key); }
+    static bool app_env_has(const char* key) { return lookup(host().app_env_, key) != nullptr; }
+    static void app_env_set(const char* key, const char* value) { host().set_app_env(key, value ? value : ""); }
+    static bool app_env_remove(const char* key) { host().app_env_generation_++; return host().app_env_.erase(key) != 0; }
+
+    static const std::map<std::string, std::string>& env_scope(EnvScope scope) {
+        return scope == ENV_SCOPE_APP ? host().app_env_ : host().flow_env_;
+    }
+
+    static bool env_try_get(EnvScope scope, const char* key, const char** out_value) {
+        const char* value = lookup(env_scope(scope), key);
+        if (out_value) {
+            *out_value = value;
+        }
+        return value != nullptr;
+    }
+
+    static EnvKey env_key_intern(const char* key) {
+        std::vector<std::string>& keys = host().env_keys_;
+        for (size_t i = 0; key && i < keys.size(); ++i) {
+            if (keys[i] == key) {
+                return (EnvKey)(i + 1);
+            }
+        }
+        if (!key) {
+            return ENV_KEY_INVALID;
+        }
+        keys.push_back(key);
+        return (EnvKey)keys.size();
+    }
+
+    static bool env_try_get_key(EnvScope scope, EnvKey key, const char** out_value) {
+        if (key == ENV_KEY_INVALID || key > host().env_keys_.size()) {
+            return false;
+        }
+        return env_try_get(scope, host().env_keys_[key - 1].c_str(), out_value);
+    }
+
+    static uint64_t env_generation(EnvScope scope) {
+        return scope == ENV_SCOPE_APP ? host().app_env_generation_ : host().flow_env_generation_;
+    }
+
+    static uint64_t settings_generation(void) { return host().settings_generation_; }
+
+    /* String interner; deque elements never move, so views stay valid */
+
+    static StringId intern(const char* str, size_t len) {
+        MockHost& h = host();
+        std::string_view key(str ? str : "", str ? len : 0);
+        auto it = h.interned_.find(key);
+        if (it != h.interned_.end()) {
+            return it->second;
+        }
+        h.interned_strings_.emplace_back(key);
+        StringId id = (StringId)h.interned_strings_.size();
+        h.interned_.emplace(h.interned_strings_.back(), id);
+        return id;
+    }
+
+    static StringView intern_lookup(StringId id) {
+        if (id == STRING_ID_INVALID || id > host().interned_strings_.size()) {
+            return StringView{"", 0};
+        }
+        const std::string& s = host().interned_strings_[id - 1];
+        return StringView{s.c_str(), s.size()};
+    }
+
+    /* Typed settings */
+
+    static const SettingsView* get_settings_view(const char* plugin_id) {
+        auto it = host().settings_views_.find(plugin_id ? plugin_id : "");
+        return it != host().settings_views_.end() ? it->second.get() : nullptr;
+    }
+
+    static const SettingsView::Value* field(const SettingsView* view, uint32_t field_id, SettingsFieldType type) {
+        if (!view || field_id >= view->values.size() || view->values[field_id].type != type) {
+            return nullptr;
+        }
+        return &view->values[field_id];
+    }
+
+    static bool settings_get_bool(const SettingsView* view, uint32_t field_id) {
+        const SettingsView::Value* v = field(view, field_id, SETTINGS_FIELD_BOOL);
+        return v ? v->b : false;
+    }
+
+    static int64_t settings_get_int(const SettingsView* view, uint32_t field_id) {
+        const SettingsView::Value* v = field(view, field_id, SETTINGS_FIELD_INT);
+        return v ? v->i : 0;
+    }
+
+    static double settings_get_float(const SettingsView* view, uint32_t field_id) {
+        const SettingsView::Value* v = field(view, field_id, SETTINGS_FIELD_FLOAT);
+        return v ? v->f : 0.0;
+    }
+
+    static const char* settings_get_string(const SettingsView* view, uint32_t field_id) {
+        const SettingsView::Value* v = field(view, field_id, SETTINGS_FIELD_STRING);
+        return v ? v->s.c_str() : "";
+    }
+
+    static const char* get_plugin_settings(const char* plugin_id) {
+        return lookup(host().plugin_settings_, plugin_id);
+    }
+
+    static const char* get_rune_setting(const char* setting_name) {
+        return lookup(host().rune_settings_, setting_name);
+    }
+
+    /* Buffers */
+
+    static bool buffer_create(uint32_t element_size, uint64_t len, BufferView* out_view) {
+        if (!out_view || element_size == 0) {
+            return false;
+        }
+        size_t bytes = (size_t)(element_size * len);
+        count_alloc(bytes);
+        BufferOwner* owner = new BufferOwner{1, aligned_malloc(RUNE_BATCH_ALIGNMENT, bytes)};
+        out_view->ptr = owner->mem;
+        out_view->len = len;
+        out_view->stride = element_size;
+        out_view->owner = owner;
+        return true;
+    }
+
+    static void buffer_retain(BufferOwner* owner) {
+        if (owner) {
+            owner->refs++;
+        }
+    }
+
+    static void buffer_release(BufferOwner* owner) {
+        if (owner && --owner->refs == 0) {
+            count_free();
+            aligned_free(owner->mem);
+            delete owner;
+        }
+    }
+
+    /* Object pools - counted individual allocations */
+
+    static ObjectPool* pool_create(uint32_t object_size, uint32_t align) {
+        return new ObjectPool{object_size, align < sizeof(void*) ? (uint32_t)sizeof(void*) : align, 0};
+    }
+
+    static void* pool_alloc(ObjectPool* pool) {
+        count_alloc(pool->object_size);
+        pool->live++;
+        return aligned_malloc(pool->align, pool->object_size);
+    }
+
+    static void pool_free(ObjectPool* pool, void* ptr) {
+        if (ptr) {
+            count_free();
+            pool->live--;
+            aligned_free(ptr);
+        }
+    }
+
+    static void pool_destroy(ObjectPool* pool) {
+        delete pool;
+    }
+
+    /* JSON documents */
+
+    static JsonDoc* json_doc_open(const char* json_str, size_t len) {
+        if (!json_str || !json_valid(json_str, json_str + len)) {
+            return nullptr;
+        }
+        JsonDoc* doc = new JsonDoc;
+        doc->source.assign(json_str, len);
+        return doc;
+    }
+
+    static void json_doc_close(JsonDoc* doc) { delete doc; }
+
+    static JsonPath* json_path_compile(const char* json_path) {
+        JsonPath* path = new JsonPath;
+        if (!compile_json_path(json_path, path)) {
+            delete path;
+            return nullptr;
+        }
+        return path;
+    }
+
+    static void json_path_free(JsonPath* path) { delete path; }
+
+    static const char* json_doc_query(JsonDoc* doc, const JsonPath* path) {
+        std::string value;
+        if (!doc || !path || !query_json(doc->source, *path, &value)) {
+            return nullptr;
+        }
+        doc->results.push_back(value);
+        return doc->results.back().c_str();
+    }
+
+    /* CSV reader */
+
+    static CsvReader* csv_reader_open(const char* data, size_t len, char delimiter) {
+        return data ? new CsvReader{data, len, 0, delimiter, std::string(), {}, {}} : nullptr;
+    }
+
+    static bool csv_reader_next_batch(CsvReader* reader, uint32_t max_rows, CsvBatch* out_batch) {
+        bool escaped;
+        if (!reader || !out_batch || max_rows == 0 || !csv_read_rows(reader, max_rows, &escaped)) {
+            return false;
+        }
+        out_batch->cells = reader->cells.data();
+        out_batch->row_offsets = reader->row_offsets.data();
+        out_batch->row_count = (uint32_t)reader->row_offsets.size() - 1;
+        out_batch->flags = escaped ? CSV_BATCH_FLAG_ESCAPED : CSV_BATCH_FLAG_NONE;
+        return true;
+    }
+
+    static void csv_reader_close(CsvReader* reader) { delete reader; }
+
+    static uint64_t csv_count_rows(const char* data, size_t len, char delimiter) {
+        CsvReader reader = {data, len, 0, delimiter, std::string(), {}, {}};
+        uint64_t rows = 0;
+        bool escaped;
+        while (csv_read_rows(&reader, 1024, &escaped)) {
+            rows += reader.row_offsets.size() - 1;
+        }
+        return rows;
+    }
+
+    /* File input - the mock reads the file instead of mapping it */
+
+    static bool file_map(const char* path, BufferView* out_view) {
+        std::string contents;
+        if (!out_view || !read_file(path, &contents) ||
+            !buffer_create(1, contents.size(), out_view)) {
+            return false;
+        }
+        std::memcpy(out_view->ptr, contents.data(), contents.size());
+        return true;
+    }
+
+    static CsvReader* csv_reader_open_mapped(const char* path, char delimiter) {
+        CsvReader* reader = new CsvReader{nullptr, 0, 0, delimiter, std::string(), {}, {}};
+        if (!read_file(path, &reader->mapped)) {
+            delete reader;
+            return nullptr;
+        }
+        reader->data = reader->mapped.data();
+        reader->len = reader->mapped.size();
+        return reader;
+    }
+
+    static JsonDoc* json_doc_open_mapped(const char* path) {
+        std::string contents;
+        return read_file(path, &contents) ? json_doc_open(contents.data(), contents.size()) : nullptr;
+    }
+
+    /* INI documents */
+
+    static IniDoc* ini_doc_open(const char* ini_str, size_t len) {
+        if (!ini_str) {
+            return nullptr;
+        }
+        IniDoc* doc = new IniDoc;
+        parse_ini(ini_str, len, doc);
+        return doc;
+    }
+
+    static IniDoc* ini_doc_open_mapped(const char* path) {
+        std::string contents;
+        return read_file(path, &contents) ? ini_doc_open(contents.data(), contents.size()) : nullptr;
+    }
+
+    static void ini_doc_close(IniDoc* doc) { delete doc; }
+
+    static const char* ini_doc_get(const IniDoc* doc, const char* section, const char* key) {
+        const IniDoc::Section* s = doc ? find_section(doc, section) : nullptr;
+        for (size_t i = 0; s && i < s->entries.size(); ++i) {
+            if (s->entries[i].key == (key ? key : "")) {
+                return s->entries[i].value.c_str();
+            }
+        }
+        return nullptr;
+    }
+
+    static bool ini_doc_next_section(const IniDoc* doc, uint32_t* cursor, StringView* out_section) {
+        if (!doc || !cursor || *cursor + 1 >= doc->sections.size()) {
+            return false;
+        }
+        const std::string& name = doc->sections[++*cursor].name;
+        *out_section = StringView{name.data(), name.size()};
+        return true;
+    }
+
+    static bool ini_doc_next_key(const IniDoc* doc, const char* section, uint32_t* cursor,
+                                 StringView* out_key, StringView* out_value) {
+        const IniDoc::Section* s = doc ? find_section(doc, section) : nullptr;
+        if (!s || !cursor || *cursor >= s->entries.size()) {
+            return false;
+        }
+        const IniDoc::Entry& e = s->entries[(*cursor)++];
+        *out_key = StringView{e.key.data(), e.key.size()};
+        *out_value = StringView{e.value.data(), e.value.size()};
+        return true;
+    }
+
+    static bool ini_doc_set(IniDoc* doc, const char* section, const char* key, const char* value) {
+        if (!doc || !key) {
+            return false;
+        }
+        IniDoc::Section* s = find_section(doc, section);
+        if (!s) {
+            doc->sections.push_back(IniDoc::Section{section ? section : "", {}});
+            s = &doc->sections.back();
+        }
+        for (IniDoc::Entry& e : s->entries) {
+            if (e.key == key) {
+                e.value = value ? value : "";
+                return true;
+            }
+        }
+        s->entries.push_back(IniDoc::Entry{key, value ? value : ""});
+        return true;
+    }
+
+    static char* ini_doc_serialize(const IniDoc* doc) {
+        std::string out;
+        for (size_t i = 0; doc && i < doc->sections.size(); ++i) {
+            if (i > 0) {
+                out += "[" + doc->sections[i].name + "]\n";
+            }
+            for (const IniDoc::Entry& e : doc->sections[i].entries) {
+                out += e.key + "=" + e.value + "\n";
+            }
+        }
+        return copy_string(host().services(), out);
+    }
+
+    /* Registry */
+
+    static PinTypeId register_pin_type(const char* name, uint32_t size, uint32_t flags) {
+        (void)name;
+        (void)size;
+        (void)flags;
+        return host().next_pin_type_++;
+    }
+
+    static NodeTypeId register_node(const NodeDesc* desc, const NodeVTable* vtbl) {
+        if (!desc || !vtbl) {
+            return 0;
+        }
+        NodeTypeId id = host().next_node_id_++;
+        host().nodes_.push_back(MockHost::RegisteredNode{id, desc, vtbl});
+        return id;
+    }
+
+    static void unregister_node(NodeTypeId type_id) {
+        std::vector<MockHost::RegisteredNode>& nodes = host().nodes_;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i].id == type_id) {
+                nodes.erase(nodes.begin() + (ptrdiff_t)i);
+                return;
+            }
+        }
+    }
+
+    static NodeTypeId find_node(const char* unique_name) {
+        const MockHost::RegisteredNode* node = unique_name ? host().find_node(unique_name) : nullptr;
+        return node ? node->id : 0;
+    }
+
+    /* Swaps the entry in place; instances are migrated by migrate_instance */
+    static bool replace_node(NodeTypeId type_id, const NodeDesc* desc, const NodeVTable* vtbl) {
+        for (MockHost::RegisteredNode& node : host().nodes_) {
+            if (node.id == type_id) {
+                if (!desc || !vtbl || std::strcmp(node.desc->unique_name, desc->unique_name) != 0) {
+                    return false;
+                }
+                node.desc = desc;
+                node.vtbl = vtbl;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static PinTypeId get_pin_type_id(const char* type_name) {
+        static const struct { const char* name; PinTypeId id; } builtin[] = {
+            {"string", PIN_TYPE_STRING}, {"int", PIN_TYPE_INT}, {"float", PIN_TYPE_FLOAT},
+            {"bool", PIN_TYPE_BOOL}, {"json", PIN_TYPE_JSON}, {"blob", PIN_TYPE_BLOB},
+            {"path", PIN_TYPE_PATH}, {"array_f32", PIN_TYPE_ARRAY_F32},
+            {"array_f64", PIN_TYPE_ARRAY_F64}, {"array_i64", PIN_TYPE_ARRAY_I64},
+            {"execution", PIN_TYPE_EXECUTION},
+        };
+        for (const auto& entry : builtin) {
+            if (type_name && std::strcmp(type_name, entry.name) == 0) {
+                return entry.id;
+            }
+        }
+        return 0;
+    }
+
+    /* Detected once, as the host does at startup */
+    static uint64_t get_cpu_features() {
+        static const uint64_t features = rune_detect_cpu_features();
+        return features;
+    }
+
+    /* Luau - LuaCFunction bindings are accepted and ignored */
+
+    static void* get_plugin_state(const char* plugin_id) {
+        (void)plugin_id;
+        static int state;
+        return &state;
+    }
+
+    static void register_global(void* L, const char* name, LuaCFunction fn) {
+        (void)L;
+        (void)name;
+        (void)fn;
+    }
+
+    static void register_library(void* L, const char* lib_name, const char** fn_names,
+                                 LuaCFunction* fn_ptrs, uint32_t count) {
+        (void)L;
+        (void)lib_name;
+        (void)fn_names;
+        (void)fn_ptrs;
+        (void)count;
+    }
+
+    static void set_sandbox_policy(void* L, const char* policy_name) {
+        (void)L;
+        (void)policy_name;
+    }
+
+    /* Checks the signature grammar the way the VM does, then records the
+     * function so benchmarks can call it */
+    static bool register_fastcall(void* L, const char* lib_name, const char* name,
+                                  const char* signature, LuaFastcallFunction fn) {
+        (void)L;
+        if (!name || !signature || !fn) {
+            return false;
+        }
+        const char* p = signature;
+        int args = 0;
+        for (; *p && *p != '-'; ++p, ++args) {
+            if (!std::strchr("dibB", *p) || args == RUNE_LUAU_FASTCALL_MAX_ARGS) {
+                return false;
+            }
+        }
+        if (p[0] != '-' || p[1] != '>' || (p[2] && (!std::strchr("dib", p[2]) || p[3]))) {
+            return false;
+        }
+        host().fastcalls_.push_back(MockHost::Fastcall{lib_name ? lib_name : "", name, signature, fn});
+        return true;
+    }
+
+    /* ExecContext */
+
+    static MockExecContext& exec(ExecContext* ctx) { return *(MockExecContext*)ctx->_internal; }
+
+    static PinHandle resolve_pin(ExecContext* ctx, const char* pin_name) {
+        return exec(ctx).find(pin_name);
+    }
+
+    static const char* get_input_string_h(ExecContext* ctx, PinHandle pin) { return exec(ctx).at(pin).s.c_str(); }
+    static int64_t get_input_int_h(ExecContext* ctx, PinHandle pin) { return exec(ctx).at(pin).i; }
+    static double get_input_float_h(ExecContext* ctx, PinHandle pin) { return exec(ctx).at(pin).f; }
+    static bool get_input_bool_h(ExecContext* ctx, PinHandle pin) { return exec(ctx).at(pin).b; }
+
+    /* Compares against the previous value as it is replaced, like the host
+     * does for change detection, so a borrowed previous value is read here */
+    static void count_string_change(MockExecContext::PinValue& v, StringView value) {
+        StringView previous = v.borrowed.ptr ? v.borrowed : StringView{v.s.data(), v.s.size()};
+        if (!rune_sv_equals(previous, value)) {
+            v.changes++;
+        }
+    }
+
+    static void set_output_string_h(ExecContext* ctx, PinHandle pin, const char* value) {
+        MockExecContext::PinValue& v = exec(ctx).at(pin);
+        count_string_change(v, rune_sv(value ? value : ""));
+        v.s = value ? value : "";
+        v.borrowed = StringView{nullptr, 0};
+    }
+    static void set_output_int_h(ExecContext* ctx, PinHandle pin, int64_t value) { exec(ctx).at(pin).i = value; }
+    static void set_output_float_h(ExecContext* ctx, PinHandle pin, double value) { exec(ctx).at(pin).f = value; }
+    static void set_output_bool_h(ExecContext* ctx, PinHandle pin, bool value) { exec(ctx).at(pin).b = value; }
+    static void trigger_output_h(ExecContext* ctx, PinHandle pin) { trigger_output_batch(ctx, pin, 1); }
+
+    /* Every trigger is its own run here, so count_pin only sees batches */
+    static void trigger_output_batch(ExecContext* ctx, PinHandle pin, uint32_t count) {
+        MockExecContext& e = exec(ctx);
+        const TriggerPolicy* policy = e.desc_ && e.host_.services()->api_version >= 2 ? e.desc_->trigger_policy : nullptr;
+        if (policy && policy->count_pin != PIN_HANDLE_INVALID) {
+            e.at(policy->count_pin).i = count;
+        }
+        e.at(pin).triggers++;
+    }
+
+    static const char* get_input_string(ExecContext* ctx, const char* pin) { return get_input_string_h(ctx, resolve_pin(ctx, pin)); }
+    static int64_t get_input_int(ExecContext* ctx, const char* pin) { return get_input_int_h(ctx, resolve_pin(ctx, pin)); }
+    static double get_input_float(ExecContext* ctx, const char* pin) { return get_input_float_h(ctx, resolve_pin(ctx, pin)); }
+    static bool get_input_bool(ExecContext* ctx, const char* pin) { return get_input_bool_h(ctx, resolve_pin(ctx, pin)); }
+
+    static void set_output_string(ExecContext* ctx, const char* pin, const char* value) { set_output_string_h(ctx, resolve_pin(ctx, pin), value); }
+    static void set_output_int(ExecContext* ctx, const char* pin, int64_t value) { set_output_int_h(ctx, resolve_pin(ctx, pin), value); }
+    static void set_output_float(ExecContext* ctx, const char* pin, double value) { set_output_float_h(ctx, resolve_pin(ctx, pin), value); }
+    static void set_output_bool(ExecContext* ctx, const char* pin, bool value) { set_output_bool_h(ctx, resolve_pin(ctx, pin), value); }
+    static void trigger_output(ExecContext* ctx, const char* pin) { trigger_output_h(ctx, resolve_pin(ctx, pin)); }
+
+    static const char* get_property(ExecContext* ctx, const char* name) {
+        return lookup(exec(ctx).properties_, name);
+    }
+
+    static void set_error(ExecContext* ctx, const char* error_msg) {
+        exec(ctx).error_ = error_msg ? error_msg : "";
+    }
+
+    static HostServices* get_host_services(ExecContext* ctx) {
+        return exec(ctx).host_.services();
+    }
+
+    static bool get_input_buffer(ExecContext* ctx, PinHandle pin, BufferView* out_view) {
+        const BufferView& view = exec(ctx).at(pin).buffer;
+        if (!out_view || !view.ptr) {
+            return false;
+        }
+        *out_view = view;
+        return true;
+    }
+
+    static void set_output_buffer(ExecContext* ctx, PinHandle pin, const BufferView* view) {
+        exec(ctx).set_buffer(pin, view ? *view : BufferView{nullptr, 0, 0, nullptr});
+    }
+
+    static void* arena_alloc(ExecContext* ctx, size_t size, size_t align) {
+        return exec(ctx).host_.arena_alloc(size, align);
+    }
+
+    static void mark_output_dirty(ExecContext* ctx, PinHandle pin) { (void)ctx; (void)pin; }
+    static void outputs_unchanged(ExecContext* ctx) { (void)ctx; }
+
+    static bool get_input_string_view(ExecContext* ctx, PinHandle pin, StringView* out_view) {
+        MockExecContext& e = exec(ctx);
+        if (pin >= e.pins_.size()) {
+            *out_view = StringView{"", 0};
+            return false;
+        }
+        *out_view = StringView{e.pins_[pin].s.data(), e.pins_[pin].s.size()};
+        return true;
+    }
+
+    static void set_output_string_view(ExecContext* ctx, PinHandle pin, StringView value) {
+        MockExecContext::PinValue& v = exec(ctx).at(pin);
+        count_string_change(v, value.ptr ? value : StringView{"", 0});
+        v.s.assign(value.ptr ? value.ptr : "", value.ptr ? value.len : 0);
+        v.borrowed = StringView{nullptr, 0};
+    }
+
+    /* Stores the pointer only, like the host */
+    static void set_output_string_borrowed(ExecContext* ctx, PinHandle pin, StringView value) {
+        MockExecContext::PinValue& v = exec(ctx).at(pin);
+        count_string_change(v, value.ptr ? value : StringView{"", 0});
+        v.borrowed = value.ptr ? value : StringView{"", 0};
+    }
+
+    static void signal_complete(ExecContext* ctx, bool success) {
+        (void)success;
+        exec(ctx).completed_ = true;
+    }
+
+    /* Applied immediately; the mock has no flow thread to queue for */
+    static bool post_event(ExecContext* ctx, PinHandle exec_pin, const EventValue* values, uint32_t value_count) {
+        for (uint32_t i = 0; i < value_count; ++i) {
+            const EventValue& v = values[i];
+            switch (v.type) {
+                case PIN_TYPE_INT:    set_output_int_h(ctx, v.pin, v.value.i); break;
+                case PIN_TYPE_FLOAT:  set_output_float_h(ctx, v.pin, v.value.f); break;
+                case PIN_TYPE_BOOL:   set_output_bool_h(ctx, v.pin, v.value.b); break;
+                case PIN_TYPE_STRING: set_output_string_h(ctx, v.pin, v.value.s); break;
+                default: break;
+            }
+        }
+        trigger_output_h(ctx, exec_pin);
+        return true;
+    }
+};
+
+/* ==========================================================================
+ * MockHost
+ * ========================================================================== */
+
+static const size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+MockHost::MockHost(uint32_t api_version) {
+    g_current = this;
+
+    services_ = HostServices{};
+    services_.api_version = api_version;
+    services_.log = Services::log;
+    services_.log_formatted = Services::log_formatted;
+    services_.submit_job = Services::submit_job;
+    services_.poll_job = Services::poll_job;
+    services_.cancel_job = Services::cancel_job;
+    services_.get_plugin_data_dir = Services::get_plugin_data_dir;
+    services_.get_cache_dir = Services::get_cache_dir;
+    services_.get_flows_dir = Services::get_flows_dir;
+    services_.has_capability = Services::has_capability;
+    services_.alloc = Services::alloc;
+    services_.free = Services::free;
+    services_.create_timer = Services::create_timer;
+    services_.destroy_timer = Services::destroy_timer;
+    services_.json_parse = Services::json_parse;
+    services_.json_stringify = Services::json_stringify;
+    services_.json_validate = Services::json_validate;
+    services_.csv_parse = Services::csv_parse;
+    services_.csv_free = Services::csv_free;
+    services_.csv_stringify = Services::csv_stringify;
+    services_.ini_get = Services::ini_get;
+    services_.ini_set = Services::ini_set;
+    services_.ini_get_sections = Services::ini_get_sections;
+    services_.ini_get_keys = Services::ini_get_keys;
+    services_.ini_free_strings = Services::ini_free_strings;
+    services_.env_get = Services::flow_env_get;
+    services_.env_has = Services::flow_env_has;
+    services_.flow_env_get = Services::flow_env_get;
+    services_.flow_env_has = Services::flow_env_has;
+    services_.flow_env_set = Services::flow_env_set;
+    services_.flow_env_remove = Services::flow_env_remove;
+    services_.app_env_get = Services::app_env_get;
+    services_.app_env_has = Services::app_env_has;
+    services_.app_env_set = Services::app_env_set;
+    services_.app_env_remove = Services::app_env_remove;
+    services_.get_plugin_settings = Services::get_plugin_settings;
+    services_.get_rune_setting = Services::get_rune_setting;
+
+    /* Version 2 services; memoization and profiling stay NULL (not provided) */
+    if (api_version >= 2) {
+        services_.buffer_create = Services::buffer_create;
+        services_.buffer_retain = Services::buffer_retain;
+        services_.buffer_release = Services::buffer_release;
+        services_.pool_create = Services::pool_create;
+        services_.pool_alloc = Services::pool_alloc;
+        services_.pool_free = Services::pool_free;
+        services_.pool_destroy = Services::pool_destroy;
+        services_.json_doc_open = Services::json_doc_open;
+        services_.json_doc_close = Services::json_doc_close;
+        services_.json_path_compile = Services::json_path_compile;
+        services_.json_path_free = Services::json_path_free;
+        services_.json_doc_query = Services::json_doc_query;
+        services_.csv_reader_open = Services::csv_reader_open;
+        services_.csv_reader_next_batch = Services::csv_reader_next_batch;
+        services_.csv_reader_close = Services::csv_reader_close;
+        services_.csv_count_rows = Services::csv_count_rows;
+        services_.file_map = Services::file_map;
+        services_.csv_reader_open_mapped = Services::csv_reader_open_mapped;
+        services_.json_doc_open_mapped = Services::json_doc_open_mapped;
+        services_.ini_doc_open = Services::ini_doc_open;
+        services_.ini_doc_open_mapped = Services::ini_doc_open_mapped;
+        services_.ini_doc_close = Services::ini_doc_close;
+        services_.ini_doc_get = Services::ini_doc_get;
+        services_.ini_doc_next_section = Services::ini_doc_next_section;
+        services_.ini_doc_next_key = Services::ini_doc_next_key;
+        services_.ini_doc_set = Services::ini_doc_set;
+        services_.ini_doc_serialize = Services::ini_doc_serialize;
+        services_.submit_job_ex = Services::submit_job_ex;
+        services_.submit_job_group = Services::submit_job_group;
+        services_.submit_job_after = Services::submit_job_after;
+        services_.parallel_for = Services::parallel_for;
+        services_.get_worker_count = Services::get_worker_count;
+        services_.wait_job = Services::wait_job;
+        services_.create_timer_ex = Services::create_timer_ex;
+        services_.get_log_level = Services::get_log_level;
+        services_.is_log_enabled = Services::is_log_enabled;
+        services_.log_register_format = Services::log_register_format;
+        services_.log_deferred = Services::log_deferred;
+        services_.env_try_get = Services::env_try_get;
+        services_.env_key_intern = Services::env_key_intern;
+        services_.env_try_get_key = Services::env_try_get_key;
+        services_.env_generation = Services::env_generation;
+        services_.settings_generation = Services::settings_generation;
+        services_.get_settings_view = Services::get_settings_view;
+        services_.settings_get_bool = Services::settings_get_bool;
+        services_.settings_get_int = Services::settings_get_int;
+        services_.settings_get_float = Services::settings_get_float;
+        services_.settings_get_string = Services::settings_get_string;
+        services_.intern = Services::intern;
+        services_.intern_lookup = Services::intern_lookup;
+        services_.get_cpu_features = Services::get_cpu_features;
+    }
+
+    registry_.register_pin_type = Services::register_pin_type;
+    registry_.register_node = Services::register_node;
+    registry_.unregister_node = Services::unregister_node;
+    registry_.get_pin_type_id = Services::get_pin_type_id;
+    if (api_version >= 2) {
+        registry_.find_node = Services::find_node;
+        registry_.replace_node = Services::replace_node;
+    }
+
+    luau_.get_plugin_state = Services::get_plugin_state;
+    luau_.register_global = Services::register_global;
+    luau_.register_library = Services::register_library;
+    luau_.set_sandbox_policy = Services::set_sandbox_policy;
+    if (api_version >= 2) {
+        luau_.register_fastcall = Services::register_fastcall;
+    }
+}
+
+MockHost::~MockHost() {
+    if (g_current == this) {
+        g_current = nullptr;
+    }
+}
+
+const MockHost::RegisteredNode* MockHost::find_node(const char* unique_name) const {
+    for (const RegisteredNode& node : nodes_) {
+        if (std::strcmp(node.desc->unique_name, unique_name) == 0) {
+            return &node;
+        }
+    }
+    return nullptr;
+}
+
+const MockHost::Fastcall* MockHost::find_fastcall(const char* lib, const char* name) const {
+    for (const Fastcall& f : fastcalls_) {
+        if (f.lib == (lib ? lib : "") && f.name == name) {
+            return &f;
+        }
+    }
+    return nullptr;
+}
+
+void* MockHost::migrate_instance(NodeTypeId type, const NodeVTable* old_vtbl, void* old_inst,
+                                 ExecContext* listening_ctx) {
+    const RegisteredNode* node = nullptr;
+    for (const RegisteredNode& n : nodes_) {
+        if (n.id == type) {
+            node = &n;
+        }
+    }
+    if (!node) {
+        return nullptr;
+    }
+
+    const NodeVTable* vtbl = node->vtbl;
+    void* inst = vtbl->create_instance ? vtbl->create_instance() : nullptr;
+    if (vtbl->create_instance && !inst) {
+        return nullptr;
+    }
+
+    migrate_writer_.clear();
+    if (old_vtbl->serialize_to && vtbl->deserialize_from &&
+        old_vtbl->serialize_to(old_inst, migrate_writer_.get())) {
+        vtbl->deserialize_from(inst, migrate_writer_.data(), migrate_writer_.size());
+    }
+
+    // Make before break
+    if (listening_ctx && vtbl->start_listening) {
+        vtbl->start_listening(inst, listening_ctx);
+    }
+    if (listening_ctx && old_vtbl->stop_listening) {
+        old_vtbl->stop_listening(old_inst);
+    }
+    if (old_vtbl->destroy_instance) {
+        old_vtbl->destroy_instance(old_inst);
+    }
+    return inst;
+}
+
+void MockHost::apply_settings(const PluginAPI* api, const std::string& json) {
+    set_plugin_settings(api->info.id, json);
+
+    const PluginSettingsSchema* schema = api->get_settings_schema ? api->get_settings_schema() : nullptr;
+    const bool typed = services_.api_version >= 2 && api->info.api_version >= 2 &&
+                       schema && schema->fields && schema->field_count > 0;
+    if (!typed) {
+        settings_views_.erase(api->info.id);
+        if (api->on_settings_changed) {
+            api->on_settings_changed(plugin_settings_[api->info.id].c_str());
+        }
+        return;
+    }
+
+    std::unique_ptr<SettingsView> view(new SettingsView);
+    for (uint32_t id = 0; id < schema->field_count; ++id) {
+        const SettingsField& field = schema->fields[id];
+        SettingsView::Value value = {field.type, false, 0, 0.0, std::string()};
+        JsonPath path;
+        std::string text;
+        bool found = compile_json_path(field.path, &path) &&
+                     (query_json(json, path, &text) ||
+                      (schema->defaults_json && query_json(schema->defaults_json, path, &text)));
+        if (found) {
+            switch (field.type) {
+                case SETTINGS_FIELD_BOOL:   value.b = (text == "true"); break;
+                case SETTINGS_FIELD_INT:    value.i = std::strtoll(text.c_str(), nullptr, 10); break;
+                case SETTINGS_FIELD_FLOAT:  value.f = std::strtod(text.c_str(), nullptr); break;
+                case SETTINGS_FIELD_STRING: value.s = text; break;
+            }
+        }
+        view->values.push_back(value);
+    }
+
+    const SettingsView* current = view.get();
+    settings_views_[api->info.id] = std::move(view);
+    if (api->on_settings_view_changed) {
+        api->on_settings_view_changed(current);
+    } else if (api->on_settings_changed) {
+        api->on_settings_changed(plugin_settings_[api->info.id].c_str());
+    }
+}
+
+void MockHost::fire_timers() {
+    std::vector<uint64_t> due;
+    for (const auto& entry : timers_) {
+        due.push_back(entry.first);
+    }
+    for (uint64_t id : due) {
+        auto it = timers_.find(id);
+        if (it == timers_.end()) {
+            continue;  /* Destroyed by an earlier callback */
+        }
+        Timer timer = it->second;
+        if (timer.one_shot) {
+            timers_.erase(it);
+        }
+        timer.callback(timer.user_data);
+    }
+}
+
+void* MockHost::arena_alloc(size_t size, size_t align) {
+    if (align == 0 || (align & (align - 1)) != 0) {
+        return nullptr;
+    }
+    counters_.allocs++;
+    counters_.alloc_bytes += size;
+
+    size_t offset = (arena_used_ + align - 1) & ~(align - 1);
+    if (arena_blocks_.empty() || offset + size > arena_block_size_) {
+        size_t block_size = size + align > ARENA_BLOCK_SIZE ? size + align : ARENA_BLOCK_SIZE;
+        arena_blocks_.emplace_back(new uint8_t[block_size]);
+        arena_block_size_ = block_size;
+        offset = 0;
+    }
+
+    uint8_t* block = arena_blocks_.back().get();
+    uintptr_t base = (uintptr_t)block;
+    size_t pad = (size_t)(((base + offset + align - 1) & ~(uintptr_t)(align - 1)) - (base + offset));
+    void* ptr = block + offset + pad;
+    arena_used_ = offset + pad + size;
+    return ptr;
+}
+
+void MockHost::end_run() {
+    /* Keep one block around so steady-state runs do not reallocate */
+    if (arena_blocks_.size() > 1 || arena_block_size_ != ARENA_BLOCK_SIZE) {
+        arena_blocks_.clear();
+        arena_block_size_ = 0;
+    }
+    arena_used_ = 0;
+}
+
+/* ==========================================================================
+ * MockExecContext
+ * ========================================================================== */
+
+MockExecContext::MockExecContext(MockHost& host, const NodeDesc* desc)
+    : host_(host), desc_(desc), ctx_(), pins_(desc ? desc->pin_count : 0) {
+    ctx_.get_input_string = Services::get_input_string;
+    ctx_.get_input_int = Services::get_input_int;
+    ctx_.get_input_float = Services::get_input_float;
+    ctx_.get_input_bool = Services::get_input_bool;
+    ctx_.get_input_json = Services::get_input_string;
+    ctx_.set_output_string = Services::set_output_string;
+    ctx_.set_output_int = Services::set_output_int;
+    ctx_.set_output_float = Services::set_output_float;
+    ctx_.set_output_bool = Services::set_output_bool;
+    ctx_.set_output_json = Services::set_output_string;
+    ctx_.get_property = Services::get_property;
+    ctx_.set_error = Services::set_error;
+    ctx_.trigger_output = Services::trigger_output;
+    ctx_.get_host_services = Services::get_host_services;
+    ctx_._internal = this;
+
+    if (host.services()->api_version >= 2) {
+        ctx_.resolve_pin = Services::resolve_pin;
+        ctx_.get_input_string_h = Services::get_input_string_h;
+        ctx_.get_input_int_h = Services::get_input_int_h;
+        ctx_.get_input_float_h = Services::get_input_float_h;
+        ctx_.get_input_bool_h = Services::get_input_bool_h;
+        ctx_.get_input_json_h = Services::get_input_string_h;
+        ctx_.set_output_string_h = Services::set_output_string_h;
+        ctx_.set_output_int_h = Services::set_output_int_h;
+        ctx_.set_output_float_h = Services::set_output_float_h;
+        ctx_.set_output_bool_h = Services::set_output_bool_h;
+        ctx_.set_output_json_h = Services::set_output_string_h;
+        ctx_.trigger_output_h = Services::trigger_output_h;
+        ctx_.get_input_buffer = Services::get_input_buffer;
+        ctx_.set_output_buffer = Services::set_output_buffer;
+        ctx_.arena_alloc = Services::arena_alloc;
+        ctx_.mark_output_dirty = Services::mark_output_dirty;
+        ctx_.outputs_unchanged = Services::outputs_unchanged;
+        ctx_.signal_complete = Services::signal_complete;
+        ctx_.post_event = Services::post_event;
+        ctx_.get_input_string_view = Services::get_input_string_view;
+        ctx_.set_output_string_view = Services::set_output_string_view;
+        ctx_.set_output_string_borrowed = Services::set_output_string_borrowed;
+        ctx_.trigger_output_batch = Services::trigger_output_batch;
+    }
+}
+
+MockExecContext::~MockExecContext() {
+    for (PinValue& pin : pins_) {
+        if (pin.buffer.owner && host_.services()->buffer_release) {
+            host_.services()->buffer_release(pin.buffer.owner);
+        }
+    }
+}
+
+PinHandle MockExecContext::find(const char* pin) const {
+    for (uint32_t i = 0; desc_ && pin && i < desc_->pin_count; ++i) {
+        if (std::strcmp(desc_->pins[i].name, pin) == 0) {
+            return i;
+        }
+    }
+    return PIN_HANDLE_INVALID;
+}
+
+/* Unknown pins read as empty values and swallow writes */
+MockExecContext::PinValue& MockExecContext::at(PinHandle pin) {
+    if (pin >= pins_.size()) {
+        invalid_ = PinValue();
+        return invalid_;
+    }
+    return pins_[pin];
+}
+
+const MockExecContext::PinValue& MockExecContext::at(PinHandle pin) const {
+    return const_cast<MockExecContext*>(this)->at(pin);
+}
+
+void MockExecContext::set_buffer(PinHandle pin, const BufferView& view) {
+    HostServices* services = host_.services();
+    PinValue& value = at(pin);
+    if (view.owner && services->buffer_retain) {
+        services->buffer_retain(view.owner);
+    }
+    if (value.buffer.owner && services->buffer_release) {
+        services->buffer_release(value.buffer.owner);
+    }
+    value.buffer = view;
+}
+
+void MockExecContext::set_input_string(const char* pin, const std::string& value) { at(find(pin)).s = value; }
+void MockExecContext::set_input_int(const char* pin, int64_t value) { at(find(pin)).i = value; }
+void MockExecContext::set_input_float(const char* pin, double value) { at(find(pin)).f = value; }
+void MockExecContext::set_input_bool(const char* pin, bool value) { at(find(pin)).b = value; }
+void MockExecContext::set_input_buffer(const char* pin, const BufferView& view) { set_buffer(find(pin), view); }
+
+std::string MockExecContext::output_string(const char* pin) const {
+    const PinValue& value = at(find(pin));
+    return value.borrowed.ptr ? std::string(value.borrowed.ptr, value.borrowed.len) : value.s;
+}
+int64_t MockExecContext::output_int(const char* pin) const { return at(find(pin)).i; }
+double MockExecContext::output_float(const char* pin) const { return at(find(pin)).f; }
+bool MockExecContext::output_bool(const char* pin) const { return at(find(pin)).b; }
+uint64_t MockExecContext::trigger_count(const char* pin) const { return at(find(pin)).triggers; }
+uint64_t MockExecContext::output_changes(const char* pin) const { return at(find(pin)).changes; }
+
+/* ==========================================================================
+ * MockSerializeWriter
+ * ========================================================================== */
+
+MockSerializeWriter::MockSerializeWriter() {
+    writer_.append = &MockSerializeWriter::append;
+    writer_._internal = this;
+    buffer_.reserve(4096);
+}
+
+bool MockSerializeWriter::append(SerializeWriter* writer, const void* data, uint32_t size) {
+    MockSerializeWriter* self = (MockSerializeWriter*)writer->_internal;
+    const uint8_t* bytes = (const uint8_t*)data;
+    self->buffer_.insert(self->buffer_.end(), bytes, bytes + size);
+    return true;
+}
+
+/* ==========================================================================
+ * PluginLibrary
+ * ========================================================================== */
+
+PluginLibrary::~PluginLibrary() {
+    close();
+}
+
+bool PluginLibrary::open(const std::string& path, std::string* error) {
+    close();
+
+#if defined(_WIN32) || defined(_WIN64)
+    HMODULE module = LoadLibraryA(path.c_str());
+    if (!module) {
+        if (error) *error = "LoadLibrary failed for " + path;
+        return false;
+    }
+    PluginGetAPIFunc get_api = (PluginGetAPIFunc)(void*)GetProcAddress(module, RUNE_PLUGIN_ENTRY_SYMBOL);
+    handle_ = (void*)module;
+#else
+    void* module = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!module) {
+        if (error) *error = dlerror();
+        return false;
+    }
+    PluginGetAPIFunc get_api = (PluginGetAPIFunc)dlsym(module, RUNE_PLUGIN_ENTRY_SYMBOL);
+    handle_ = module;
+#endif
+
+    api_ = get_api ? get_api() : nullptr;
+    if (!api_) {
+        if (error) *error = path + ": missing " RUNE_PLUGIN_ENTRY_SYMBOL;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void PluginLibrary::close() {
+    if (handle_) {
+#if defined(_WIN32) || defined(_WIN64)
+        FreeLibrary((HMODULE)handle_);
+#else
+        dlclose(handle_);
+#endif
+    }
+    handle_ = nullptr;
+    api_ = nullptr;
+}
+
+} // namespace mock
+} // namespace rune
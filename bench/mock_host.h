@@ -0,0 +1,288 @@
+/**
+ * RUNE Plugin SDK - Mock Host
+ *
+ * In-process stand-in for the RUNE host, for benchmarking and exercising
+ * plugins without the application. Provides:
+ *   - MockHost:        HostServices, PluginNodeRegistry and LuauRegistry
+ *   - MockExecContext: an ExecContext bound to one node type's pins
+ *   - MockSerializeWriter: the host's shared state buffer for serialize_to
+ *   - PluginLibrary:   loads a plugin shared library via NodePlugin_GetAPI
+ *
+ * Everything runs on the calling thread: jobs execute inline, and timers only
+ * fire when fire_timers() is called. The JSON/CSV/INI services are small
+ * reference implementations, so benchmarks through them measure plugin-side
+ * overhead rather than the real host's parsers.
+ *
+ * Link against Rune::mock_host. Only one MockHost may exist at a time,
+ * because HostServices callbacks carry no context pointer.
+ */
+
+#ifndef RUNE_MOCK_HOST_H
+#define RUNE_MOCK_HOST_H
+
+#include "rune_plugin.h"
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rune {
+namespace mock {
+
+/* ==========================================================================
+ * MockSerializeWriter - growable buffer behind SerializeWriter
+ *
+ * Like the host's flow writer, one instance is reused across nodes: clear()
+ * keeps the capacity, so steady-state serialization does not allocate.
+ * ========================================================================== */
+
+class MockSerializeWriter {
+public:
+    MockSerializeWriter();
+
+    SerializeWriter* get() { return &writer_; }
+    const uint8_t* data() const { return buffer_.data(); }
+    uint32_t size() const { return (uint32_t)buffer_.size(); }
+    void clear() { buffer_.clear(); }
+
+private:
+    static bool append(SerializeWriter* writer, const void* data, uint32_t size);
+
+    SerializeWriter writer_;
+    std::vector<uint8_t> buffer_;
+};
+
+/* ==========================================================================
+ * MockHost
+ * ========================================================================== */
+
+class MockHost {
+public:
+    struct RegisteredNode {
+        NodeTypeId        id;
+        const NodeDesc*   desc;
+        const NodeVTable* vtbl;
+    };
+
+    /* Allocations made through host services (alloc, pools, arenas, buffers) */
+    struct Counters {
+        uint64_t allocs;
+        uint64_t frees;
+        uint64_t alloc_bytes;
+    };
+
+    explicit MockHost(uint32_t api_version = RUNE_PLUGIN_API_VERSION);
+    ~MockHost();
+
+    MockHost(const MockHost&) = delete;
+    MockHost& operator=(const MockHost&) = delete;
+
+    HostServices*       services() { return &services_; }
+    PluginNodeRegistry* registry() { return &registry_; }
+    LuauRegistry*       luau() { return &luau_; }
+
+    /* Registered node types */
+    const std::vector<RegisteredNode>& nodes() const { return nodes_; }
+    const RegisteredNode* find_node(const char* unique_name) const;
+
+    /* Luau fast calls that passed signature validation; lib is "" for globals */
+    struct Fastcall {
+        std::string         lib;
+        std::string         name;
+        std::string         signature;
+        LuaFastcallFunction fn;
+    };
+    const std::vector<Fastcall>& fastcalls() const { return fastcalls_; }
+    const Fastcall* find_fastcall(const char* lib, const char* name) const;
+
+    /* Hot-reload one instance after replace_node, as the host does: state
+     * moves through serialize_to / deserialize_from, a listening instance
+     * (listening_ctx set) starts on the new vtable before the old one stops,
+     * and old_inst is destroyed with old_vtbl. Returns the new instance. */
+    void* migrate_instance(NodeTypeId type, const NodeVTable* old_vtbl, void* old_inst,
+                           ExecContext* listening_ctx);
+
+    /* Environment and settings seen by the plugin */
+    void set_flow_env(const std::string& key, const std::string& value) { flow_env_[key] = value; flow_env_generation_++; }
+    void set_app_env(const std::string& key, const std::string& value) { app_env_[key] = value; app_env_generation_++; }
+    void set_rune_setting(const std::string& name, const std::string& value) { rune_settings_[name] = value; settings_generation_++; }
+    void set_plugin_settings(const std::string& plugin_id, const std::string& json) { plugin_settings_[plugin_id] = json; settings_generation_++; }
+
+    /* Deliver a settings change to a loaded plugin the way the host does:
+     * through on_settings_view_changed when the schema declares fields and
+     * the plugin implements it, otherwise through on_settings_changed. */
+    void apply_settings(const PluginAPI* api, const std::string& json);
+
+    /* Messages below this level are dropped */
+    void set_log_level(PluginLogLevel level) { log_level_ = level; }
+
+    /* log_deferred calls received, including dropped ones */
+    uint64_t deferred_logs() const { return deferred_logs_; }
+
+    /* Fire every active timer once; one-shot timers are then released */
+    void fire_timers();
+    size_t active_timers() const { return timers_.size(); }
+
+    /* Release all arena memory, as at the end of a flow run */
+    void end_run();
+
+    Counters counters() const { return counters_; }
+    void reset_counters() { counters_ = Counters{0, 0, 0}; }
+
+    /* The host currently installed (used by the C callbacks) */
+    static MockHost* current();
+
+private:
+    friend struct Services;
+    friend class MockExecContext;
+
+    struct LogFormat {
+        PluginLogLevel level;
+        const char*    format;
+    };
+
+    struct Timer {
+        TimerCallback callback;
+        void*         user_data;
+        bool          one_shot;
+    };
+
+    void* arena_alloc(size_t size, size_t align);
+
+    HostServices       services_;
+    PluginNodeRegistry registry_;
+    LuauRegistry       luau_;
+
+    std::vector<RegisteredNode> nodes_;
+    std::vector<Fastcall> fastcalls_;
+    NodeTypeId next_node_id_ = 1;
+    PinTypeId next_pin_type_ = PIN_TYPE_CUSTOM_START;
+
+    std::map<std::string, std::string> flow_env_;
+    std::map<std::string, std::string> app_env_;
+    std::map<std::string, std::string> rune_settings_;
+    std::map<std::string, std::string> plugin_settings_;
+    std::map<std::string, std::unique_ptr<SettingsView>, std::less<>> settings_views_;
+    std::vector<std::string> env_keys_;  /* EnvKey k names env_keys_[k - 1] */
+    std::unordered_map<std::string_view, StringId> interned_;  /* Keys view interned_strings_ */
+    std::deque<std::string> interned_strings_;  /* StringId k is interned_strings_[k - 1] */
+    uint64_t flow_env_generation_ = 1;
+    uint64_t app_env_generation_ = 1;
+    uint64_t settings_generation_ = 1;
+
+    std::map<uint64_t, Timer> timers_;
+    uint64_t next_timer_id_ = 1;
+    uint64_t next_job_id_ = 1;
+
+    std::vector<std::unique_ptr<uint8_t[]>> arena_blocks_;
+    size_t arena_used_ = 0;
+    size_t arena_block_size_ = 0;
+
+    std::string scratch_;  /* Backing store for returned strings */
+    PluginLogLevel log_level_ = PLUGIN_LOG_LEVEL_WARN;
+    std::vector<LogFormat> log_formats_;
+    uint64_t deferred_logs_ = 0;
+    Counters counters_ = {0, 0, 0};
+    MockSerializeWriter migrate_writer_;
+};
+
+/* ==========================================================================
+ * MockExecContext
+ * ========================================================================== */
+
+class MockExecContext {
+public:
+    MockExecContext(MockHost& host, const NodeDesc* desc);
+    ~MockExecContext();
+
+    MockExecContext(const MockExecContext&) = delete;
+    MockExecContext& operator=(const MockExecContext&) = delete;
+
+    ExecContext* get() { return &ctx_; }
+
+    /* Inputs (by pin name) */
+    void set_input_string(const char* pin, const std::string& value);
+    void set_input_int(const char* pin, int64_t value);
+    void set_input_float(const char* pin, double value);
+    void set_input_bool(const char* pin, bool value);
+    void set_input_buffer(const char* pin, const BufferView& view);
+    void set_property(const std::string& name, const std::string& value) { properties_[name] = value; }
+
+    /* Outputs (by pin name) */
+    std::string output_string(const char* pin) const;  /* Copied or borrowed value */
+    int64_t output_int(const char* pin) const;
+    double output_float(const char* pin) const;
+    bool output_bool(const char* pin) const;
+
+    /* Number of times an execution output fired (trigger_output / post_event) */
+    uint64_t trigger_count(const char* pin) const;
+
+    /* Number of string output sets that changed the pin's value */
+    uint64_t output_changes(const char* pin) const;
+
+    const std::string& error() const { return error_; }
+    bool completed() const { return completed_; }
+    void clear() { error_.clear(); completed_ = false; }
+
+private:
+    friend struct Services;
+
+    struct PinValue {
+        std::string s;
+        StringView  borrowed = {nullptr, 0};  /* Overrides s when ptr is set */
+        int64_t     i = 0;
+        double      f = 0.0;
+        bool        b = false;
+        BufferView  buffer = {nullptr, 0, 0, nullptr};
+        uint64_t    triggers = 0;
+        uint64_t    changes = 0;
+    };
+
+    PinHandle find(const char* pin) const;
+    PinValue& at(PinHandle pin);
+    const PinValue& at(PinHandle pin) const;
+    void set_buffer(PinHandle pin, const BufferView& view);
+
+    MockHost& host_;
+    const NodeDesc* desc_;
+    ExecContext ctx_;
+    std::vector<PinValue> pins_;
+    PinValue invalid_;  /* Target for unknown pins */
+    std::map<std::string, std::string> properties_;
+    std::string error_;
+    bool completed_ = false;
+};
+
+/* ==========================================================================
+ * PluginLibrary - dlopen / LoadLibrary wrapper
+ * ========================================================================== */
+
+class PluginLibrary {
+public:
+    PluginLibrary() = default;
+    ~PluginLibrary();
+
+    PluginLibrary(const PluginLibrary&) = delete;
+    PluginLibrary& operator=(const PluginLibrary&) = delete;
+
+    /* Load the library and resolve RUNE_PLUGIN_ENTRY_SYMBOL */
+    bool open(const std::string& path, std::string* error);
+    void close();
+
+    const PluginAPI* api() const { return api_; }
+
+private:
+    void* handle_ = nullptr;
+    const PluginAPI* api_ = nullptr;
+};
+
+} // namespace mock
+} // namespace rune
+
+#endif /* RUNE_MOCK_HOST_H */
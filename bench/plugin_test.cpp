@@ -0,0 +1,189 @@
+/**
+ * RUNE Plugin SDK - Example plugin tests
+ *
+ * Loads the example plugins into a MockHost, like rune_plugin_bench, and
+ * checks node behavior that depends on the order of host callbacks.
+ *
+ * Usage: rune_plugin_test (exit status 0 on success)
+ */
+
+#include "mock_host.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using rune::mock::MockExecContext;
+using rune::mock::MockHost;
+using rune::mock::PluginLibrary;
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,    \
+                         __LINE__, #cond);                                  \
+            g_failures++;                                                   \
+        }                                                                   \
+    } while (0)
+
+/* ==========================================================================
+ * Config plugin
+ * ========================================================================== */
+
+static void test_json_parse_after_memo_hit(MockHost& host) {
+    const MockHost::RegisteredNode* node = host.find_node("com.rune.example.config.json_parse");
+    CHECK(node);
+    if (!node) {
+        return;
+    }
+
+    MockExecContext ctx(host, node->desc);
+    void* inst = node->vtbl->create_instance();
+    ctx.set_input_string("JSON", "{\"a\":\"first\"}");
+    ctx.set_input_string("Path", "a");
+    CHECK(node->vtbl->execute(inst, ctx.get()));
+    CHECK(ctx.output_string("Value") == "first");
+
+    // A memo hit for other inputs publishes cached outputs without execute
+    ctx.get()->set_output_string(ctx.get(), "Value", "second");
+
+    // Back on the first inputs, the node must publish its value again
+    CHECK(node->vtbl->execute(inst, ctx.get()));
+    CHECK(ctx.output_string("Value") == "first");
+
+    node->vtbl->destroy_instance(inst);
+}
+
+static void test_json_parse_replaces_borrowed_value(MockHost& host) {
+    const MockHost::RegisteredNode* node = host.find_node("com.rune.example.config.json_parse");
+    CHECK(node);
+    if (!node) {
+        return;
+    }
+
+    MockExecContext ctx(host, node->desc);
+    void* inst = node->vtbl->create_instance();
+    ctx.set_input_string("Path", "a");
+    ctx.set_input_string("JSON", "{\"a\":\"one\"}");
+    CHECK(node->vtbl->execute(inst, ctx.get()));
+
+    // Setting the new value compares it against the previous one, which
+    // borrows from the document the new JSON input replaces (equal lengths,
+    // so the bytes are compared)
+    ctx.set_input_string("JSON", "{\"a\":\"two\"}");
+    CHECK(node->vtbl->execute(inst, ctx.get()));
+    CHECK(ctx.output_string("Value") == "two");
+    CHECK(ctx.output_changes("Value") == 2);
+
+    node->vtbl->destroy_instance(inst);
+}
+
+static void test_csv_first_cell(MockHost& host) {
+    const MockHost::RegisteredNode* node = host.find_node("com.rune.example.config.csv_parse");
+    CHECK(node);
+    if (!node) {
+        return;
+    }
+
+    MockExecContext ctx(host, node->desc);
+    ctx.set_input_string("CSV", "name,qty\nwidget,3\n");
+    CHECK(node->vtbl->execute(nullptr, ctx.get()));
+    CHECK(ctx.output_int("RowCount") == 2);
+    CHECK(ctx.output_string("FirstCell") == "name");
+
+    // Only a cell with doubled quotes is unescaped
+    ctx.set_input_string("CSV", "\"say \"\"hi\"\"\",qty\n");
+    CHECK(node->vtbl->execute(nullptr, ctx.get()));
+    CHECK(ctx.output_string("FirstCell") == "say \"hi\"");
+}
+
+/* ==========================================================================
+ * Timer plugin
+ * ========================================================================== */
+
+/* Delay instance re-executed from its own completion signal */
+static const MockHost::RegisteredNode* g_delay = nullptr;
+static void* g_delay_inst = nullptr;
+static int g_delay_signals = 0;
+
+static void reexecute_on_complete(ExecContext* ctx, bool success) {
+    (void)success;
+    // The host may run the node again as soon as completion is signalled
+    if (++g_delay_signals == 1) {
+        CHECK(g_delay->vtbl->execute(g_delay_inst, ctx));
+    }
+}
+
+static void test_delay_reexecute_on_complete(MockHost& host) {
+    g_delay = host.find_node("com.rune.example.timer.delay");
+    CHECK(g_delay);
+    if (!g_delay) {
+        return;
+    }
+
+    MockExecContext ctx(host, g_delay->desc);
+    ctx.set_input_int("DelayMs", 10);
+    ctx.get()->signal_complete = reexecute_on_complete;
+    g_delay_inst = g_delay->vtbl->create_instance();
+    g_delay_signals = 0;
+
+    CHECK(g_delay->vtbl->execute(g_delay_inst, ctx.get()));
+    CHECK(host.active_timers() == 1);
+    host.fire_timers();
+    CHECK(g_delay_signals == 1);
+    CHECK(ctx.trigger_count("OnComplete") == 1);
+
+    // The second run's timer must still belong to the instance
+    CHECK(host.active_timers() == 1);
+    g_delay->vtbl->destroy_instance(g_delay_inst);
+    CHECK(host.active_timers() == 0);
+    g_delay_inst = nullptr;
+}
+
+/* ==========================================================================
+ * Main
+ * ========================================================================== */
+
+int main() {
+    MockHost host;
+
+    const char* plugin_paths[] = {
+        RUNE_TEST_CONFIG_PLUGIN,
+        RUNE_TEST_TIMER_PLUGIN,
+    };
+    std::vector<PluginLibrary*> plugins;
+    for (const char* path : plugin_paths) {
+        PluginLibrary* plugin = new PluginLibrary;
+        std::string error;
+        if (!plugin->open(path, &error)) {
+            std::fprintf(stderr, "failed to load plugin: %s\n", error.c_str());
+            return 1;
+        }
+        const PluginAPI* api = plugin->api();
+        if (!api->on_load(host.services())) {
+            std::fprintf(stderr, "%s: on_load failed\n", api->info.id);
+            return 1;
+        }
+        api->on_register(host.registry(), host.luau());
+        plugins.push_back(plugin);
+    }
+
+    test_json_parse_after_memo_hit(host);
+    test_json_parse_replaces_borrowed_value(host);
+    test_csv_first_cell(host);
+    test_delay_reexecute_on_complete(host);
+
+    for (size_t i = plugins.size(); i-- > 0;) {
+        plugins[i]->api()->on_unload();
+        delete plugins[i];
+    }
+
+    if (g_failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("rune_plugin_test: all checks passed\n");
+    return 0;
+}
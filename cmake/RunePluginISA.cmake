@@ -0,0 +1,106 @@
+# RUNE Plugin SDK - Multi-ISA plugin builds
+#
+# rune_add_plugin_isa_variants(<target>
+#     SOURCES <file>...
+#     [ISAS <isa>...])
+#
+# Adds SOURCES to <target> as the baseline build, then compiles them again
+# once per ISA in ISAS (default: all) that the target processor and compiler
+# support, and links those copies into <target> as well. Select between them
+# at runtime with rune_cpu_features and rune_select_kernel (rune_plugin.h).
+#
+#   ISA      Flags (GCC/Clang)                      Runtime check
+#   sse4_2   -msse4.2                               RUNE_CPU_SSE4_2
+#   avx2     -mavx2 -mfma                           RUNE_CPU_AVX2 | RUNE_CPU_FMA
+#   avx512   -mavx512f/bw/dq/vl -mavx2 -mfma        RUNE_CPU_AVX512
+#   neon     AArch64 baseline, no separate build    RUNE_CPU_NEON
+#
+# Each copy is compiled with RUNE_ISA_SUFFIX=_<isa> (the baseline has none),
+# so RUNE_ISA_SYMBOL(name) gives every copy its own exported names, and with
+# the include directories, definitions and options of <target>. <target>
+# gets RUNE_ISA_HAS_<ISA> for every copy that was built.
+#
+# Keep everything in SOURCES except the RUNE_ISA_SYMBOL names at internal
+# linkage (static or an anonymous namespace). The linker keeps only one copy
+# of an inline function with external linkage, and it may be an AVX-512 one.
+
+include_guard(GLOBAL)
+
+include(CheckCCompilerFlag)
+include(CheckCXXCompilerFlag)
+
+function(rune_add_plugin_isa_variants target)
+    cmake_parse_arguments(RUNE_ISA "" "" "SOURCES;ISAS" ${ARGN})
+    if(NOT RUNE_ISA_SOURCES)
+        message(FATAL_ERROR "rune_add_plugin_isa_variants(${target}): SOURCES is required")
+    endif()
+    if(NOT RUNE_ISA_ISAS)
+        set(RUNE_ISA_ISAS sse4_2 avx2 avx512 neon)
+    endif()
+
+    target_sources(${target} PRIVATE ${RUNE_ISA_SOURCES})
+
+    if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i[3-6]86|x86)$")
+        set(x86 ON)
+    else()
+        set(x86 OFF)
+    endif()
+
+    get_property(languages GLOBAL PROPERTY ENABLED_LANGUAGES)
+
+    foreach(isa IN LISTS RUNE_ISA_ISAS)
+        set(flags "")
+        if(isa STREQUAL "neon")
+            continue()
+        elseif(NOT isa MATCHES "^(sse4_2|avx2|avx512)$")
+            message(FATAL_ERROR "rune_add_plugin_isa_variants(${target}): unknown ISA '${isa}'")
+        elseif(NOT x86)
+            continue()
+        elseif(MSVC)
+            # MSVC has no SSE4.2 switch; its intrinsics are always available
+            if(isa STREQUAL "avx2")
+                set(flags /arch:AVX2)
+            elseif(isa STREQUAL "avx512")
+                set(flags /arch:AVX512)
+            endif()
+        else()
+            if(isa STREQUAL "sse4_2")
+                set(flags -msse4.2)
+            elseif(isa STREQUAL "avx2")
+                set(flags -mavx2 -mfma)
+            else()
+                set(flags -mavx512f -mavx512bw -mavx512dq -mavx512vl -mavx2 -mfma)
+            endif()
+        endif()
+
+        if(flags)
+            string(REPLACE ";" " " flags_string "${flags}")
+            if("CXX" IN_LIST languages)
+                check_cxx_compiler_flag("${flags_string}" RUNE_ISA_COMPILER_HAS_${isa})
+            else()
+                check_c_compiler_flag("${flags_string}" RUNE_ISA_COMPILER_HAS_${isa})
+            endif()
+            if(NOT RUNE_ISA_COMPILER_HAS_${isa})
+                message(STATUS "${target}: compiler lacks ${isa} support, skipping that variant")
+                continue()
+            endif()
+        endif()
+
+        set(variant ${target}_${isa})
+        add_library(${variant} OBJECT ${RUNE_ISA_SOURCES})
+        set_target_properties(${variant} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+        target_include_directories(${variant} PRIVATE $<TARGET_PROPERTY:${target},INCLUDE_DIRECTORIES>)
+        target_compile_definitions(${variant} PRIVATE
+            $<TARGET_PROPERTY:${target},COMPILE_DEFINITIONS>
+            RUNE_ISA_SUFFIX=_${isa}
+        )
+        target_compile_options(${variant} PRIVATE
+            $<TARGET_PROPERTY:${target},COMPILE_OPTIONS>
+            ${flags}
+        )
+
+        string(TOUPPER ${isa} isa_upper)
+        target_compile_definitions(${target} PRIVATE RUNE_ISA_HAS_${isa_upper})
+        target_sources(${target} PRIVATE $<TARGET_OBJECTS:${variant}>)
+    endforeach()
+endfunction()
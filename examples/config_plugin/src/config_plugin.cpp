@@ -11,9 +11,18 @@
 #include "rune_plugin.h"
 #include <cstring>
 #include <cstdio>
+#include <string>
 
 static HostServices* g_host = nullptr;
 
+// Settings paths, compiled once in on_load when the host supports JsonDoc
+static JsonPath* g_path_enabled = nullptr;
+static JsonPath* g_path_log_level = nullptr;
+
+static bool has_json_doc_api(HostServices* host) {
+    return RUNE_HOST_API_AT_LEAST(host, 2) && host->json_doc_open && host->json_path_compile;
+}
+
 /* ============================================================================
  * Settings Schema
  * ============================================================================ */
@@ -55,27 +64,73 @@ static const char* SETTINGS_DEFAULTS = R"({
     "api_key": ""
 })";
 
+// Typed fields delivered through on_settings_view_changed; IDs are indices
+enum {
+    CONFIG_SETTING_ENABLED   = 0,
+    CONFIG_SETTING_LOG_LEVEL = 1,
+    CONFIG_SETTING_MAX_ITEMS = 2,
+    CONFIG_SETTING_API_KEY   = 3
+};
+
+static const SettingsField g_settingsFields[] = {
+    {"enabled", SETTINGS_FIELD_BOOL},
+    {"log_level", SETTINGS_FIELD_STRING},
+    {"max_items", SETTINGS_FIELD_INT},
+    {"api_key", SETTINGS_FIELD_STRING},
+};
+
 static PluginSettingsSchema g_settingsSchema = {
     SETTINGS_SCHEMA,
-    SETTINGS_DEFAULTS
+    SETTINGS_DEFAULTS,
+    g_settingsFields,
+    (uint32_t)(sizeof(g_settingsFields) / sizeof(g_settingsFields[0]))
 };
 
 static const PluginSettingsSchema* get_settings_schema(void) {
     return &g_settingsSchema;
 }
 
+static void log_setting(const char* name, const char* value) {
+    if (value && value[0] != '\0') {
+        RUNE_LOG_DEBUG(g_host, "  %s = %s", name, value);
+    }
+}
+
 static void on_settings_changed(const char* settings_json) {
     if (g_host) {
         g_host->log(LOG_LEVEL_INFO, "Config plugin settings changed");
         
-        // Parse the enabled flag
-        const char* enabled = g_host->json_parse(settings_json, "enabled");
-        if (enabled && enabled[0] != '\0') {
-            g_host->log_formatted(LOG_LEVEL_DEBUG, "  enabled = %s", enabled);
+        // Parse the document once and query each field from it
+        JsonDoc* doc = NULL;
+        if (g_path_enabled && g_path_log_level && settings_json) {
+            doc = g_host->json_doc_open(settings_json, strlen(settings_json));
+        }
+        
+        if (doc) {
+            log_setting("enabled", g_host->json_doc_query(doc, g_path_enabled));
+            log_setting("log_level", g_host->json_doc_query(doc, g_path_log_level));
+            g_host->json_doc_close(doc);
+        } else {
+            log_setting("enabled", g_host->json_parse(settings_json, "enabled"));
+            log_setting("log_level", g_host->json_parse(settings_json, "log_level"));
         }
     }
 }
 
+// Version 2 hosts deliver the settings already parsed and type-checked
+static void on_settings_view_changed(const SettingsView* view) {
+    if (!g_host || !g_host->settings_get_bool) {
+        return;
+    }
+    
+    g_host->log(LOG_LEVEL_INFO, "Config plugin settings changed");
+    RUNE_LOG_DEBUG(g_host, "  enabled = %s",
+                   g_host->settings_get_bool(view, CONFIG_SETTING_ENABLED) ? "true" : "false");
+    log_setting("log_level", g_host->settings_get_string(view, CONFIG_SETTING_LOG_LEVEL));
+    RUNE_LOG_DEBUG(g_host, "  max_items = %lld",
+                   (long long)g_host->settings_get_int(view, CONFIG_SETTING_MAX_ITEMS));
+}
+
 /* ============================================================================
  * Menu Items
  * ============================================================================ */
@@ -141,22 +196,128 @@ static const MenuRegistration* get_menus(uint32_t* count) {
 }
 
 /* ============================================================================
- * JSON Parse Node
+ * Stateless node instances (CSV Parse)
  * ============================================================================ */
 
-static void* json_parse_create(void) {
+// Only version 1 hosts call these; later hosts honor NODE_FLAG_STATELESS
+static void* stateless_create(void) {
     return nullptr;
 }
 
-static void json_parse_destroy(void* inst) {
+static void stateless_destroy(void* inst) {
     (void)inst;
 }
 
-static bool json_parse_execute(void* inst, ExecContext* ctx) {
-    (void)inst;
+/* ============================================================================
+ * JSON Parse Node
+ * 
+ * Caches the parsed document and compiled path on the instance, so repeated
+ * executions with the same inputs do not re-parse anything. Instances only
+ * exist on version 2 hosts, which pass the inputs as string views and take
+ * the result borrowed from the cached document.
+ * 
+ * The node is memoizable, so the host may skip execute on cache hits and the
+ * instance cannot know which outputs were published last. It therefore sets
+ * its outputs on every run (the host's own comparison finds them unchanged)
+ * rather than calling outputs_unchanged.
+ * ============================================================================ */
+
+enum {
+    JSON_PARSE_PIN_JSON  = 1,
+    JSON_PARSE_PIN_PATH  = 2,
+    JSON_PARSE_PIN_VALUE = 4,
+    JSON_PARSE_PIN_VALID = 5
+};
+
+typedef struct JsonParseInstance {
+    JsonDoc* doc;             // NULL if doc_source is not valid JSON
+    JsonPath* path;
+    const char* result;       // Query result, owned by doc; NULL if none
+    std::string doc_source;   // Input the cached document was parsed from
+    std::string path_source;  // Input the cached path was compiled from
+    bool cached;              // doc/path reflect doc_source/path_source
+} JsonParseInstance;
+
+static void* json_parse_create(void) {
+    if (!has_json_doc_api(g_host)) {
+        return nullptr;
+    }
+    return new JsonParseInstance{nullptr, nullptr, nullptr, std::string(), std::string(), false};
+}
+
+static void json_parse_destroy(void* inst_ptr) {
+    JsonParseInstance* inst = (JsonParseInstance*)inst_ptr;
+    if (inst) {
+        if (inst->doc) {
+            g_host->json_doc_close(inst->doc);
+        }
+        if (inst->path) {
+            g_host->json_path_free(inst->path);
+        }
+        delete inst;
+    }
+}
+
+// When both inputs match the previous run the cached result is returned
+// without re-parsing or re-querying. A replaced document is handed back in
+// *retired rather than closed: the previous Value output still borrows from
+// it until the new one is set.
+static bool same_source(const std::string& source, StringView input) {
+    return rune_sv_equals(StringView{source.data(), source.size()}, input);
+}
+
+static const char* json_parse_cached(JsonParseInstance* inst, HostServices* host,
+                                     StringView json_str, StringView path, JsonDoc** retired) {
+    *retired = NULL;
+    bool same_doc = inst->cached && same_source(inst->doc_source, json_str);
+    bool same_path = inst->cached && same_source(inst->path_source, path);
+    if (same_doc && same_path) {
+        return inst->result;
+    }
     
-    const char* json_str = ctx->get_input_string(ctx, "JSON");
-    const char* path = ctx->get_input_string(ctx, "Path");
+    if (!same_doc) {
+        *retired = inst->doc;
+        uint64_t scope = RUNE_PROFILE_BEGIN(host, "config.json_doc_open");
+        inst->doc_source.assign(json_str.ptr, json_str.len);
+        inst->doc = host->json_doc_open(inst->doc_source.data(), inst->doc_source.size());
+        RUNE_PROFILE_END(host, scope);
+    }
+    
+    if (!same_path) {
+        if (inst->path) {
+            host->json_path_free(inst->path);
+        }
+        inst->path_source.assign(path.ptr, path.len);
+        inst->path = host->json_path_compile(inst->path_source.c_str());
+    }
+    
+    inst->cached = true;
+    inst->result = (inst->doc && inst->path) ? host->json_doc_query(inst->doc, inst->path) : NULL;
+    return inst->result;
+}
+
+// Parses a file through a memory mapping instead of the JSON string input.
+// The file may change between runs, so nothing is cached.
+static bool json_parse_file_execute(ExecContext* ctx, HostServices* host,
+                                    const char* file, const char* path) {
+    JsonDoc* doc = host->json_doc_open_mapped(file);
+    JsonPath* compiled = doc ? host->json_path_compile(path ? path : "") : NULL;
+    const char* result = compiled ? host->json_doc_query(doc, compiled) : NULL;
+    
+    ctx->set_output_string(ctx, "Value", result ? result : "");
+    ctx->set_output_bool(ctx, "Valid", result && result[0] != '\0');
+    
+    if (compiled) {
+        host->json_path_free(compiled);
+    }
+    if (doc) {
+        host->json_doc_close(doc);
+    }
+    return true;
+}
+
+static bool json_parse_execute(void* inst, ExecContext* ctx) {
+    const char* file = ctx->get_input_string(ctx, "File");
     
     HostServices* host = ctx->get_host_services(ctx);
     if (!host) {
@@ -164,7 +325,43 @@ static bool json_parse_execute(void* inst, ExecContext* ctx) {
         return false;
     }
     
+    if (file && file[0]) {
+        if (!has_json_doc_api(host) || !host->json_doc_open_mapped) {
+            ctx->set_error(ctx, "File input requires host file mapping support");
+            return false;
+        }
+        if (inst) {
+            // The outputs now come from the file; re-parse the JSON input
+            // from scratch when it is used again
+            ((JsonParseInstance*)inst)->cached = false;
+        }
+        return json_parse_file_execute(ctx, host, file, ctx->get_input_string(ctx, "Path"));
+    }
+    
+    if (inst) {
+        StringView json_str;
+        StringView path;
+        ctx->get_input_string_view(ctx, JSON_PARSE_PIN_JSON, &json_str);
+        ctx->get_input_string_view(ctx, JSON_PARSE_PIN_PATH, &path);
+        
+        JsonDoc* retired;
+        const char* result = json_parse_cached((JsonParseInstance*)inst, host, json_str, path, &retired);
+        
+        // Owned by the cached document, which stays open until the inputs
+        // change on a later run and the output is replaced, or the instance
+        // is destroyed
+        ctx->set_output_string_borrowed(ctx, JSON_PARSE_PIN_VALUE, rune_sv(result));
+        ctx->set_output_bool_h(ctx, JSON_PARSE_PIN_VALID, result && result[0] != '\0');
+        if (retired) {
+            host->json_doc_close(retired);
+        }
+        return true;
+    }
+    
+    const char* json_str = ctx->get_input_string(ctx, "JSON");
+    const char* path = ctx->get_input_string(ctx, "Path");
     const char* result = host->json_parse(json_str, path);
+    
     ctx->set_output_string(ctx, "Value", result ? result : "");
     ctx->set_output_bool(ctx, "Valid", result && result[0] != '\0');
     
@@ -189,6 +386,7 @@ static PinDesc json_parse_pins[] = {
     RUNE_EXEC_PIN_OUT("Done"),
     RUNE_DATA_PIN_OUT("Value", "string"),
     RUNE_DATA_PIN_OUT("Valid", "bool"),
+    {"File", "path", PIN_IN, PIN_KIND_DATA, PIN_FLAG_OPTIONAL},  // Overrides JSON when set
 };
 
 static int json_color[] = {100, 150, 200};
@@ -198,22 +396,63 @@ static NodeDesc json_parse_desc = {
     "Config",
     "com.rune.example.config.json_parse",
     json_parse_pins,
-    6,
-    NODE_FLAG_NONE,
+    7,
+    NODE_FLAG_MEMOIZABLE | NODE_FLAG_THREAD_SAFE,
     json_color,
     NULL,
-    "Parse JSON and extract value at path"
+    "Parse JSON (or a JSON file) and extract value at path"
 };
 
 /* ============================================================================
  * CSV Parse Node
  * ============================================================================ */
 
+enum {
+    CSV_PARSE_PIN_FIRST_CELL = 5
+};
+
+static bool has_csv_reader_api(HostServices* host) {
+    return RUNE_HOST_API_AT_LEAST(host, 2) && host->csv_reader_open && host->csv_count_rows;
+}
+
+// Counts rows and reads only the first one through the streaming reader,
+// instead of materializing every cell of the document. The cell is output
+// straight from the source bytes; only a cell with doubled quotes goes
+// through an unescaped arena copy first.
+static void csv_first_row_stats(ExecContext* ctx, HostServices* host,
+                                const char* csv_str, size_t len, char delimiter) {
+    ctx->set_output_int(ctx, "RowCount", (int64_t)host->csv_count_rows(csv_str, len, delimiter));
+    
+    StringView first_cell = {"", 0};
+    CsvReader* reader = host->csv_reader_open(csv_str, len, delimiter);
+    CsvBatch batch;
+    if (reader && host->csv_reader_next_batch(reader, 1, &batch) &&
+        batch.row_count > 0 && batch.row_offsets[1] > batch.row_offsets[0]) {
+        StringView cell = batch.cells[batch.row_offsets[0]];
+        if ((batch.flags & CSV_BATCH_FLAG_ESCAPED) && memchr(cell.ptr, '"', cell.len)) {
+            char* copy = (char*)ctx->arena_alloc(ctx, cell.len + 1, 1);
+            if (copy) {
+                first_cell.len = rune_csv_unescape(cell, copy, cell.len + 1);
+                first_cell.ptr = copy;
+            }
+        } else {
+            first_cell = cell;
+        }
+    }
+    
+    // Copies the bytes out of the source, which may be a mapped file
+    ctx->set_output_string_view(ctx, CSV_PARSE_PIN_FIRST_CELL, first_cell);
+    if (reader) {
+        host->csv_reader_close(reader);
+    }
+}
+
 static bool csv_parse_execute(void* inst, ExecContext* ctx) {
     (void)inst;
     
     const char* csv_str = ctx->get_input_string(ctx, "CSV");
     const char* delimiter_str = ctx->get_input_string(ctx, "Delimiter");
+    const char* file = ctx->get_input_string(ctx, "File");
     char delimiter = (delimiter_str && delimiter_str[0]) ? delimiter_str[0] : ',';
     
     HostServices* host = ctx->get_host_services(ctx);
@@ -222,6 +461,28 @@ static bool csv_parse_execute(void* inst, ExecContext* ctx) {
         return false;
     }
     
+    if (file && file[0]) {
+        // Parse straight out of the mapped file - no read or string pin copy
+        BufferView view;
+        if (!has_csv_reader_api(host) || !host->file_map || !host->buffer_release) {
+            ctx->set_error(ctx, "File input requires host file mapping support");
+            return false;
+        }
+        if (!host->file_map(file, &view)) {
+            ctx->set_error(ctx, "Failed to map CSV file");
+            return false;
+        }
+        csv_first_row_stats(ctx, host, (const char*)view.ptr, (size_t)view.len, delimiter);
+        host->buffer_release(view.owner);
+        return true;
+    }
+    
+    if (has_csv_reader_api(host)) {
+        const char* data = csv_str ? csv_str : "";
+        csv_first_row_stats(ctx, host, data, strlen(data), delimiter);
+        return true;
+    }
+    
     CsvData* data = host->csv_parse(csv_str, delimiter);
     if (!data) {
         ctx->set_output_int(ctx, "RowCount", 0);
@@ -242,8 +503,8 @@ static bool csv_parse_execute(void* inst, ExecContext* ctx) {
 }
 
 static NodeVTable csv_parse_vtable = {
-    json_parse_create,
-    json_parse_destroy,
+    stateless_create,
+    stateless_destroy,
     NULL, NULL,
     NULL, NULL,
     csv_parse_execute,
@@ -259,6 +520,7 @@ static PinDesc csv_parse_pins[] = {
     RUNE_EXEC_PIN_OUT("Done"),
     RUNE_DATA_PIN_OUT("RowCount", "int"),
     RUNE_DATA_PIN_OUT("FirstCell", "string"),
+    {"File", "path", PIN_IN, PIN_KIND_DATA, PIN_FLAG_OPTIONAL},  // Overrides CSV when set
 };
 
 static NodeDesc csv_parse_desc = {
@@ -266,20 +528,62 @@ static NodeDesc csv_parse_desc = {
     "Config",
     "com.rune.example.config.csv_parse",
     csv_parse_pins,
-    6,
-    NODE_FLAG_NONE,
+    7,
+    NODE_FLAG_STATELESS | NODE_FLAG_THREAD_SAFE,
     json_color,
     NULL,
-    "Parse CSV data"
+    "Parse CSV data (or a CSV file)"
 };
 
 /* ============================================================================
  * INI Get Node
+ * 
+ * Keeps the parsed INI document on the instance and only re-parses when the
+ * INI input changes; lookups then go through the document's index.
  * ============================================================================ */
 
-static bool ini_get_execute(void* inst, ExecContext* ctx) {
-    (void)inst;
+typedef struct IniGetInstance {
+    IniDoc* doc;         // NULL if the host could not parse source
+    std::string source;  // Input the cached document was parsed from
+    bool cached;
+} IniGetInstance;
+
+static bool has_ini_doc_api(HostServices* host) {
+    return RUNE_HOST_API_AT_LEAST(host, 2) && host->ini_doc_open && host->ini_doc_get;
+}
+
+static void* ini_get_create(void) {
+    if (!has_ini_doc_api(g_host)) {
+        return nullptr;
+    }
+    return new IniGetInstance{nullptr, std::string(), false};
+}
+
+static void ini_get_destroy(void* inst_ptr) {
+    IniGetInstance* inst = (IniGetInstance*)inst_ptr;
+    if (inst) {
+        if (inst->doc) {
+            g_host->ini_doc_close(inst->doc);
+        }
+        delete inst;
+    }
+}
+
+static const char* ini_get_cached(IniGetInstance* inst, HostServices* host, const char* ini_str,
+                                  const char* section, const char* key) {
+    if (!inst->cached || inst->source != ini_str) {
+        if (inst->doc) {
+            host->ini_doc_close(inst->doc);
+        }
+        inst->source = ini_str;
+        inst->doc = host->ini_doc_open(inst->source.data(), inst->source.size());
+        inst->cached = true;
+    }
     
+    return inst->doc ? host->ini_doc_get(inst->doc, section ? section : "", key ? key : "") : NULL;
+}
+
+static bool ini_get_execute(void* inst, ExecContext* ctx) {
     const char* ini_str = ctx->get_input_string(ctx, "INI");
     const char* section = ctx->get_input_string(ctx, "Section");
     const char* key = ctx->get_input_string(ctx, "Key");
@@ -290,7 +594,9 @@ static bool ini_get_execute(void* inst, ExecContext* ctx) {
         return false;
     }
     
-    const char* value = host->ini_get(ini_str, section, key);
+    const char* value = inst
+        ? ini_get_cached((IniGetInstance*)inst, host, ini_str ? ini_str : "", section, key)
+        : host->ini_get(ini_str, section, key);
     ctx->set_output_string(ctx, "Value", value ? value : "");
     ctx->set_output_bool(ctx, "Found", value && value[0] != '\0');
     
@@ -298,8 +604,8 @@ static bool ini_get_execute(void* inst, ExecContext* ctx) {
 }
 
 static NodeVTable ini_get_vtable = {
-    json_parse_create,
-    json_parse_destroy,
+    ini_get_create,
+    ini_get_destroy,
     NULL, NULL,
     NULL, NULL,
     ini_get_execute,
@@ -326,7 +632,7 @@ static NodeDesc ini_get_desc = {
     "com.rune.example.config.ini_get",
     ini_get_pins,
     7,
-    NODE_FLAG_NONE,
+    NODE_FLAG_THREAD_SAFE,
     ini_color,
     NULL,
     "Get value from INI configuration"
@@ -340,14 +646,21 @@ static bool on_load(HostServices* host) {
     g_host = host;
     host->log(LOG_LEVEL_INFO, "Config plugin loaded");
     
-    // Demo: Test JSON validation
-    bool valid = host->json_validate("{\"test\": 123}");
-    host->log_formatted(LOG_LEVEL_DEBUG, "JSON validation test: %s", valid ? "passed" : "failed");
+    if (has_json_doc_api(host)) {
+        g_path_enabled = host->json_path_compile("enabled");
+        g_path_log_level = host->json_path_compile("log_level");
+    }
     
-    // Demo: Test INI parsing
-    const char* test_ini = "[section]\nkey=value\n";
-    const char* val = host->ini_get(test_ini, "section", "key");
-    host->log_formatted(LOG_LEVEL_DEBUG, "INI get test: %s", val ? val : "(null)");
+    // Demo: exercise the JSON and INI services. Only worth the startup cost
+    // when someone is reading debug output.
+    if (rune_log_enabled(host, PLUGIN_LOG_LEVEL_DEBUG)) {
+        bool valid = host->json_validate("{\"test\": 123}");
+        RUNE_LOG_DEBUG(host, "JSON validation test: %s", valid ? "passed" : "failed");
+        
+        const char* test_ini = "[section]\nkey=value\n";
+        const char* val = host->ini_get(test_ini, "section", "key");
+        RUNE_LOG_DEBUG(host, "INI get test: %s", val ? val : "(null)");
+    }
     
     return true;
 }
@@ -366,8 +679,16 @@ static void on_register(PluginNodeRegistry* reg, LuauRegistry* luau) {
 
 static void on_unload(void) {
     if (g_host) {
+        if (g_path_enabled) {
+            g_host->json_path_free(g_path_enabled);
+        }
+        if (g_path_log_level) {
+            g_host->json_path_free(g_path_log_level);
+        }
         g_host->log(LOG_LEVEL_INFO, "Config plugin unloaded");
     }
+    g_path_enabled = nullptr;
+    g_path_log_level = nullptr;
     g_host = nullptr;
 }
 
@@ -388,7 +709,8 @@ static PluginAPI g_api = {
     NULL,  // on_flow_unloaded
     get_settings_schema,
     on_settings_changed,
-    get_menus
+    get_menus,
+    on_settings_view_changed
 };
 
 NODEPLUG_EXPORT const PluginAPI* NodePlugin_GetAPI(void) {
@@ -40,9 +40,22 @@ static const char* SETTINGS_DEFAULTS = R"({
     "show_debug_info": false
 })";
 
+// Typed fields delivered through on_settings_view_changed; IDs are indices
+enum {
+    ENV_SETTING_DEFAULT_ENV_VAR = 0,
+    ENV_SETTING_SHOW_DEBUG_INFO = 1
+};
+
+static const SettingsField g_settingsFields[] = {
+    {"default_env_var", SETTINGS_FIELD_STRING},
+    {"show_debug_info", SETTINGS_FIELD_BOOL},
+};
+
 static PluginSettingsSchema g_settingsSchema = {
     SETTINGS_SCHEMA,
-    SETTINGS_DEFAULTS
+    SETTINGS_DEFAULTS,
+    g_settingsFields,
+    (uint32_t)(sizeof(g_settingsFields) / sizeof(g_settingsFields[0]))
 };
 
 static const PluginSettingsSchema* get_settings_schema(void) {
@@ -60,10 +73,23 @@ static void on_settings_changed(const char* settings_json) {
     }
 }
 
+// Version 2 hosts deliver the settings already parsed and type-checked
+static void on_settings_view_changed(const SettingsView* view) {
+    if (!g_host || !g_host->settings_get_bool) {
+        return;
+    }
+    
+    g_host->log(LOG_LEVEL_INFO, "Env plugin settings changed");
+    if (g_host->settings_get_bool(view, ENV_SETTING_SHOW_DEBUG_INFO)) {
+        g_host->log(LOG_LEVEL_DEBUG, "Debug mode enabled");
+    }
+}
+
 /* ============================================================================
  * Get Environment Variable Node
  * ============================================================================ */
 
+// Only version 1 hosts call these; later hosts honor NODE_FLAG_STATELESS
 static void* env_get_create(void) {
     return nullptr;
 }
@@ -83,17 +109,19 @@ static bool env_get_execute(void* inst, ExecContext* ctx) {
         return false;
     }
     
-    // Check if variable exists
-    bool exists = RUNE_ENV_HAS(host, var_name);
-    ctx->set_output_bool(ctx, "Exists", exists);
-    
-    if (exists) {
-        const char* value = RUNE_ENV_GET(host, var_name);
-        ctx->set_output_string(ctx, "Value", value ? value : "");
+    // One combined lookup on version 2 hosts, has + get otherwise
+    const char* value = NULL;
+    bool exists;
+    if (RUNE_HOST_API_AT_LEAST(host, 2) && host->env_try_get) {
+        exists = RUNE_ENV_TRY_GET(host, var_name, &value);
     } else {
-        ctx->set_output_string(ctx, "Value", "");
+        exists = RUNE_ENV_HAS(host, var_name);
+        value = exists ? RUNE_ENV_GET(host, var_name) : NULL;
     }
     
+    ctx->set_output_bool(ctx, "Exists", exists);
+    ctx->set_output_string(ctx, "Value", value ? value : "");
+    
     return true;
 }
 
@@ -124,7 +152,7 @@ static NodeDesc env_get_desc = {
     "com.rune.example.env.get_env",
     env_get_pins,
     5,
-    NODE_FLAG_NONE,
+    NODE_FLAG_STATELESS,
     env_color,
     NULL,
     "Get environment variable value from .env files or flow environment"
@@ -177,7 +205,7 @@ static NodeDesc plugin_settings_desc = {
     "com.rune.example.env.get_plugin_settings",
     plugin_settings_pins,
     4,
-    NODE_FLAG_NONE,
+    NODE_FLAG_STATELESS,
     settings_color,
     NULL,
     "Get a plugin's current settings as JSON"
@@ -232,7 +260,7 @@ static NodeDesc rune_setting_desc = {
     "com.rune.example.env.get_rune_setting",
     rune_setting_pins,
     5,
-    NODE_FLAG_NONE,
+    NODE_FLAG_STATELESS,
     rune_color,
     NULL,
     "Get a RUNE application setting (cache_directory, flows_directory, etc.)"
@@ -246,21 +274,25 @@ static bool on_load(HostServices* host) {
     g_host = host;
     host->log(LOG_LEVEL_INFO, "Environment plugin loaded");
     
-    // Demo: Check environment variable access
-    if (host->env_has("PATH")) {
-        host->log(LOG_LEVEL_DEBUG, "PATH environment variable is accessible");
-    }
-    
-    // Demo: Read RUNE settings
-    const char* cache_dir = host->get_rune_setting("cache_directory");
-    if (cache_dir && cache_dir[0]) {
-        host->log_formatted(LOG_LEVEL_DEBUG, "RUNE cache directory: %s", cache_dir);
-    }
-    
-    // Demo: Read own plugin settings
-    const char* settings = host->get_plugin_settings(PLUGIN_ID);
-    if (settings) {
-        host->log_formatted(LOG_LEVEL_DEBUG, "Plugin settings: %s", settings);
+    // Demo lookups below only feed debug output; skip them otherwise so
+    // loading stays cheap.
+    if (rune_log_enabled(host, PLUGIN_LOG_LEVEL_DEBUG)) {
+        // Demo: Check environment variable access
+        if (host->env_has("PATH")) {
+            host->log(LOG_LEVEL_DEBUG, "PATH environment variable is accessible");
+        }
+        
+        // Demo: Read RUNE settings
+        const char* cache_dir = host->get_rune_setting("cache_directory");
+        if (cache_dir && cache_dir[0]) {
+            RUNE_LOG_DEBUG(host, "RUNE cache directory: %s", cache_dir);
+        }
+        
+        // Demo: Read own plugin settings
+        const char* settings = host->get_plugin_settings(PLUGIN_ID);
+        if (settings) {
+            RUNE_LOG_DEBUG(host, "Plugin settings: %s", settings);
+        }
     }
     
     return true;
@@ -302,7 +334,8 @@ static PluginAPI g_api = {
     NULL,  // on_flow_unloaded
     get_settings_schema,
     on_settings_changed,
-    NULL   // get_menus
+    NULL,  // get_menus
+    on_settings_view_changed
 };
 
 NODEPLUG_EXPORT const PluginAPI* NodePlugin_GetAPI(void) {
@@ -0,0 +1,90 @@
+/**
+ * Math Plugin - Batch kernels, one build per ISA variant
+ *
+ * Vectorized with AVX-512, AVX2 or NEON when the variant is compiled for
+ * them and scalar otherwise. Everything but the exported table has internal
+ * linkage, so the variants' copies of the helpers cannot be mixed up at
+ * link time.
+ *
+ * Columns are RUNE_BATCH_ALIGNMENT aligned, so aligned loads/stores are used
+ * for the vector body and a scalar loop handles the tail.
+ */
+
+#include "rune_plugin.h"
+#include "math_kernels.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+#if defined(__AVX512F__)
+#define MATH_SIMD_LANES 8
+typedef __m512d simd_f64;
+inline simd_f64 simd_load(const double* p) { return _mm512_load_pd(p); }
+inline void simd_store(double* p, simd_f64 v) { _mm512_store_pd(p, v); }
+inline simd_f64 simd_add(simd_f64 a, simd_f64 b) { return _mm512_add_pd(a, b); }
+inline simd_f64 simd_mul(simd_f64 a, simd_f64 b) { return _mm512_mul_pd(a, b); }
+inline simd_f64 simd_div(simd_f64 a, simd_f64 b) { return _mm512_div_pd(a, b); }
+#elif defined(__AVX2__)
+#define MATH_SIMD_LANES 4
+typedef __m256d simd_f64;
+inline simd_f64 simd_load(const double* p) { return _mm256_load_pd(p); }
+inline void simd_store(double* p, simd_f64 v) { _mm256_store_pd(p, v); }
+inline simd_f64 simd_add(simd_f64 a, simd_f64 b) { return _mm256_add_pd(a, b); }
+inline simd_f64 simd_mul(simd_f64 a, simd_f64 b) { return _mm256_mul_pd(a, b); }
+inline simd_f64 simd_div(simd_f64 a, simd_f64 b) { return _mm256_div_pd(a, b); }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define MATH_SIMD_LANES 2
+typedef float64x2_t simd_f64;
+inline simd_f64 simd_load(const double* p) { return vld1q_f64(p); }
+inline void simd_store(double* p, simd_f64 v) { vst1q_f64(p, v); }
+inline simd_f64 simd_add(simd_f64 a, simd_f64 b) { return vaddq_f64(a, b); }
+inline simd_f64 simd_mul(simd_f64 a, simd_f64 b) { return vmulq_f64(a, b); }
+inline simd_f64 simd_div(simd_f64 a, simd_f64 b) { return vdivq_f64(a, b); }
+#endif
+
+struct AddOp {
+    static inline double scalar(double a, double b) { return a + b; }
+#ifdef MATH_SIMD_LANES
+    static inline simd_f64 vector(simd_f64 a, simd_f64 b) { return simd_add(a, b); }
+#endif
+};
+
+struct MultiplyOp {
+    static inline double scalar(double a, double b) { return a * b; }
+#ifdef MATH_SIMD_LANES
+    static inline simd_f64 vector(simd_f64 a, simd_f64 b) { return simd_mul(a, b); }
+#endif
+};
+
+struct DivideOp {
+    static inline double scalar(double a, double b) { return a / b; }
+#ifdef MATH_SIMD_LANES
+    static inline simd_f64 vector(simd_f64 a, simd_f64 b) { return simd_div(a, b); }
+#endif
+};
+
+template <typename Op>
+void binary_kernel(const double* a, const double* b, double* out, uint32_t count) {
+    uint32_t i = 0;
+#ifdef MATH_SIMD_LANES
+    for (; i + MATH_SIMD_LANES <= count; i += MATH_SIMD_LANES) {
+        simd_store(out + i, Op::vector(simd_load(a + i), simd_load(b + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = Op::scalar(a[i], b[i]);
+    }
+}
+
+}  // namespace
+
+extern const MathKernels RUNE_ISA_SYMBOL(math_kernels) = {
+    binary_kernel<AddOp>,
+    binary_kernel<MultiplyOp>,
+    binary_kernel<DivideOp>
+};
@@ -0,0 +1,31 @@
+/**
+ * Math Plugin - Batch kernels
+ *
+ * math_kernels.cpp is compiled once per ISA variant (see CMakeLists.txt);
+ * each copy defines its own MathKernels table and on_load picks one with
+ * rune_select_kernel.
+ */
+
+#ifndef MATH_PLUGIN_KERNELS_H
+#define MATH_PLUGIN_KERNELS_H
+
+#include <cstdint>
+
+/* Columns are RUNE_BATCH_ALIGNMENT aligned */
+typedef void (*MathBinaryKernel)(const double* a, const double* b, double* out, uint32_t count);
+
+typedef struct MathKernels {
+    MathBinaryKernel add;
+    MathBinaryKernel multiply;
+    MathBinaryKernel divide;
+} MathKernels;
+
+extern const MathKernels math_kernels_baseline;
+#ifdef RUNE_ISA_HAS_AVX2
+extern const MathKernels math_kernels_avx2;
+#endif
+#ifdef RUNE_ISA_HAS_AVX512
+extern const MathKernels math_kernels_avx512;
+#endif
+
+#endif /* MATH_PLUGIN_KERNELS_H */
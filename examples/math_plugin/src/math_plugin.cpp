@@ -3,21 +3,69 @@
  * 
  * Demonstrates creating pure data nodes (NODE_FLAG_PURE_DATA).
  * These nodes perform calculations without execution flow.
+ *
+ * All math nodes share the same pin layout, so pins are addressed through
+ * constant handles (PinDesc indices) when the host supports API version 2.
+ * Each node also provides an execute_batch kernel; the plugin carries
+ * baseline, AVX2 and AVX-512 builds of them and picks one at load time
+ * from the CPU's features (NEON is part of the AArch64 baseline). The scalar
+ * nodes describe themselves in NodeIr so hosts can fuse chains of them, and
+ * the operations are exported to Luau as typed fast calls.
  */
 
 #define NODEPLUG_BUILDING
 #include "rune_plugin.h"
+#include "math_kernels.h"
 #include <cmath>
 #include <cstring>
 
 static HostServices* g_host = nullptr;
+static bool g_pin_handles = false;
+static const MathKernels* g_kernels = &math_kernels_baseline;
+static NodeTypeId g_power_type = 0;
+
+/* Pin handles - indices into each node's PinDesc array */
+enum {
+    MATH_PIN_A      = 0,  /* "A" or "Base" */
+    MATH_PIN_B      = 1,  /* "B" or "Exponent" */
+    MATH_PIN_RESULT = 2
+};
+
+static inline double get_float(ExecContext* ctx, PinHandle pin, const char* name) {
+    return g_pin_handles ? ctx->get_input_float_h(ctx, pin) : ctx->get_input_float(ctx, name);
+}
+
+static inline void set_float(ExecContext* ctx, PinHandle pin, const char* name, double value) {
+    if (g_pin_handles) {
+        ctx->set_output_float_h(ctx, pin, value);
+    } else {
+        ctx->set_output_float(ctx, name, value);
+    }
+}
+
+/* ============================================================================
+ * Batch Kernels
+ *
+ * The column loops live in math_kernels.cpp, built for several ISAs; on_load
+ * points g_kernels at the best variant this CPU runs.
+ * ============================================================================ */
+
+template <MathBinaryKernel MathKernels::*Kernel>
+static bool binary_execute_batch(void* inst, const BatchContext* batch, uint32_t count) {
+    (void)inst;
+    (g_kernels->*Kernel)(RUNE_BATCH_COLUMN(batch, MATH_PIN_A, const double),
+                         RUNE_BATCH_COLUMN(batch, MATH_PIN_B, const double),
+                         RUNE_BATCH_COLUMN(batch, MATH_PIN_RESULT, double),
+                         count);
+    return true;
+}
 
 /* ============================================================================
  * Add Node
  * ============================================================================ */
 
 static void* add_create(void) {
-    return nullptr; // No instance data needed
+    return nullptr; // No instance data needed (NODE_FLAG_STATELESS; only version 1 hosts call this)
 }
 
 static void add_destroy(void* inst) {
@@ -27,11 +75,11 @@ static void add_destroy(void* inst) {
 static bool add_execute(void* inst, ExecContext* ctx) {
     (void)inst;
     
-    double a = ctx->get_input_float(ctx, "A");
-    double b = ctx->get_input_float(ctx, "B");
+    double a = get_float(ctx, MATH_PIN_A, "A");
+    double b = get_float(ctx, MATH_PIN_B, "B");
     double result = a + b;
     
-    ctx->set_output_float(ctx, "Result", result);
+    set_float(ctx, MATH_PIN_RESULT, "Result", result);
     return true;
 }
 
@@ -43,7 +91,8 @@ static NodeVTable add_vtable = {
     add_execute,
     NULL, NULL,     // on_pre_execute, on_post_execute
     NULL, NULL,     // start_listening, stop_listening
-    NULL            // is_complete
+    NULL,           // is_complete
+    binary_execute_batch<&MathKernels::add>
 };
 
 static PinDesc add_pins[] = {
@@ -54,16 +103,27 @@ static PinDesc add_pins[] = {
 
 static int add_color[] = {100, 200, 100};
 
+// Lets the host fuse this node into compiled pure-data chains
+static const NodeIrInstr add_ir_code[] = {
+    RUNE_IR_INPUT(0, MATH_PIN_A),
+    RUNE_IR_INPUT(1, MATH_PIN_B),
+    RUNE_IR_OP(NODE_IR_OP_ADD, 0, 0, 1),
+    RUNE_IR_OUTPUT(MATH_PIN_RESULT, 0),
+};
+
+static const NodeIr add_ir = RUNE_DEFINE_NODE_IR(add_ir_code, 2);
+
 static NodeDesc add_desc = {
     "Add",
     "Math",
     "com.rune.example.math.add",
     add_pins,
     3,
-    NODE_FLAG_PURE_DATA,
+    NODE_FLAG_PURE_DATA | NODE_FLAG_STATELESS | NODE_FLAG_THREAD_SAFE,
     add_color,
     NULL,
-    "Add two numbers together"
+    "Add two numbers together",
+    &add_ir
 };
 
 /* ============================================================================
@@ -73,11 +133,11 @@ static NodeDesc add_desc = {
 static bool multiply_execute(void* inst, ExecContext* ctx) {
     (void)inst;
     
-    double a = ctx->get_input_float(ctx, "A");
-    double b = ctx->get_input_float(ctx, "B");
+    double a = get_float(ctx, MATH_PIN_A, "A");
+    double b = get_float(ctx, MATH_PIN_B, "B");
     double result = a * b;
     
-    ctx->set_output_float(ctx, "Result", result);
+    set_float(ctx, MATH_PIN_RESULT, "Result", result);
     return true;
 }
 
@@ -89,7 +149,8 @@ static NodeVTable multiply_vtable = {
     multiply_execute,
     NULL, NULL,
     NULL, NULL,
-    NULL
+    NULL,
+    binary_execute_batch<&MathKernels::multiply>
 };
 
 static PinDesc multiply_pins[] = {
@@ -98,16 +159,26 @@ static PinDesc multiply_pins[] = {
     {"Result", "float", PIN_OUT, PIN_KIND_DATA, 0},
 };
 
+static const NodeIrInstr multiply_ir_code[] = {
+    RUNE_IR_INPUT(0, MATH_PIN_A),
+    RUNE_IR_INPUT(1, MATH_PIN_B),
+    RUNE_IR_OP(NODE_IR_OP_MUL, 0, 0, 1),
+    RUNE_IR_OUTPUT(MATH_PIN_RESULT, 0),
+};
+
+static const NodeIr multiply_ir = RUNE_DEFINE_NODE_IR(multiply_ir_code, 2);
+
 static NodeDesc multiply_desc = {
     "Multiply",
     "Math",
     "com.rune.example.math.multiply",
     multiply_pins,
     3,
-    NODE_FLAG_PURE_DATA,
+    NODE_FLAG_PURE_DATA | NODE_FLAG_STATELESS | NODE_FLAG_THREAD_SAFE,
     add_color,
     NULL,
-    "Multiply two numbers"
+    "Multiply two numbers",
+    &multiply_ir
 };
 
 /* ============================================================================
@@ -117,8 +188,8 @@ static NodeDesc multiply_desc = {
 static bool divide_execute(void* inst, ExecContext* ctx) {
     (void)inst;
     
-    double a = ctx->get_input_float(ctx, "A");
-    double b = ctx->get_input_float(ctx, "B");
+    double a = get_float(ctx, MATH_PIN_A, "A");
+    double b = get_float(ctx, MATH_PIN_B, "B");
     
     if (b == 0.0) {
         ctx->set_error(ctx, "Division by zero");
@@ -126,10 +197,23 @@ static bool divide_execute(void* inst, ExecContext* ctx) {
     }
     
     double result = a / b;
-    ctx->set_output_float(ctx, "Result", result);
+    set_float(ctx, MATH_PIN_RESULT, "Result", result);
     return true;
 }
 
+static bool divide_execute_batch(void* inst, const BatchContext* batch, uint32_t count) {
+    const double* b = RUNE_BATCH_COLUMN(batch, MATH_PIN_B, const double);
+    
+    // Let the host re-run through divide_execute so the failing row is reported
+    for (uint32_t i = 0; i < count; ++i) {
+        if (b[i] == 0.0) {
+            return false;
+        }
+    }
+    
+    return binary_execute_batch<&MathKernels::divide>(inst, batch, count);
+}
+
 static NodeVTable divide_vtable = {
     add_create,
     add_destroy,
@@ -138,7 +222,8 @@ static NodeVTable divide_vtable = {
     divide_execute,
     NULL, NULL,
     NULL, NULL,
-    NULL
+    NULL,
+    divide_execute_batch
 };
 
 static PinDesc divide_pins[] = {
@@ -147,16 +232,27 @@ static PinDesc divide_pins[] = {
     {"Result", "float", PIN_OUT, PIN_KIND_DATA, 0},
 };
 
+static const NodeIrInstr divide_ir_code[] = {
+    RUNE_IR_INPUT(0, MATH_PIN_A),
+    RUNE_IR_INPUT(1, MATH_PIN_B),
+    RUNE_IR_GUARD_NONZERO(1),  // B == 0 falls back to divide_execute's error
+    RUNE_IR_OP(NODE_IR_OP_DIV, 0, 0, 1),
+    RUNE_IR_OUTPUT(MATH_PIN_RESULT, 0),
+};
+
+static const NodeIr divide_ir = RUNE_DEFINE_NODE_IR(divide_ir_code, 2);
+
 static NodeDesc divide_desc = {
     "Divide",
     "Math",
     "com.rune.example.math.divide",
     divide_pins,
     3,
-    NODE_FLAG_PURE_DATA,
+    NODE_FLAG_PURE_DATA | NODE_FLAG_STATELESS | NODE_FLAG_THREAD_SAFE,
     add_color,
     NULL,
-    "Divide A by B"
+    "Divide A by B",
+    &divide_ir
 };
 
 /* ============================================================================
@@ -166,11 +262,25 @@ static NodeDesc divide_desc = {
 static bool power_execute(void* inst, ExecContext* ctx) {
     (void)inst;
     
-    double base = ctx->get_input_float(ctx, "Base");
-    double exponent = ctx->get_input_float(ctx, "Exponent");
+    double base = get_float(ctx, MATH_PIN_A, "Base");
+    double exponent = get_float(ctx, MATH_PIN_B, "Exponent");
     double result = pow(base, exponent);
     
-    ctx->set_output_float(ctx, "Result", result);
+    set_float(ctx, MATH_PIN_RESULT, "Result", result);
+    return true;
+}
+
+static bool power_execute_batch(void* inst, const BatchContext* batch, uint32_t count) {
+    (void)inst;
+    
+    const double* base = RUNE_BATCH_COLUMN(batch, MATH_PIN_A, const double);
+    const double* exponent = RUNE_BATCH_COLUMN(batch, MATH_PIN_B, const double);
+    double* result = RUNE_BATCH_COLUMN(batch, MATH_PIN_RESULT, double);
+    
+    // No vector pow() - the batch still saves the per-row dispatch and lookups
+    for (uint32_t i = 0; i < count; ++i) {
+        result[i] = pow(base[i], exponent[i]);
+    }
     return true;
 }
 
@@ -182,7 +292,8 @@ static NodeVTable power_vtable = {
     power_execute,
     NULL, NULL,
     NULL, NULL,
-    NULL
+    NULL,
+    power_execute_batch
 };
 
 static PinDesc power_pins[] = {
@@ -191,46 +302,234 @@ static PinDesc power_pins[] = {
     {"Result", "float", PIN_OUT, PIN_KIND_DATA, 0},
 };
 
+static const NodeIrInstr power_ir_code[] = {
+    RUNE_IR_INPUT(0, MATH_PIN_A),
+    RUNE_IR_INPUT(1, MATH_PIN_B),
+    RUNE_IR_OP(NODE_IR_OP_POW, 0, 0, 1),
+    RUNE_IR_OUTPUT(MATH_PIN_RESULT, 0),
+};
+
+static const NodeIr power_ir = RUNE_DEFINE_NODE_IR(power_ir_code, 2);
+
 static NodeDesc power_desc = {
     "Power",
     "Math",
     "com.rune.example.math.power",
     power_pins,
     3,
-    NODE_FLAG_PURE_DATA,
+    // pow() costs more than a cache lookup
+    NODE_FLAG_PURE_DATA | NODE_FLAG_MEMOIZABLE | NODE_FLAG_STATELESS | NODE_FLAG_THREAD_SAFE,
     add_color,
     NULL,
-    "Raise Base to the power of Exponent"
+    "Raise Base to the power of Exponent",
+    &power_ir
 };
 
+/* ============================================================================
+ * Array Sum Node
+ * 
+ * Reduces an array_f64 input in place through its BufferView (no copies).
+ * Large arrays are summed in chunks via HostServices::parallel_for.
+ * ============================================================================ */
+
+enum {
+    ARRAY_SUM_PIN_VALUES = 0,
+    ARRAY_SUM_PIN_SUM    = 1,
+    ARRAY_SUM_PIN_COUNT  = 2
+};
+
+// Arrays at least this long are split across the host job system
+static const uint64_t ARRAY_SUM_PARALLEL_MIN = 1 << 16;
+static const uint64_t ARRAY_SUM_GRAIN = 1 << 14;
+
+typedef struct ArraySumJob {
+    const uint8_t* base;
+    uint32_t stride;
+    double* partials;  // One slot per ARRAY_SUM_GRAIN-sized chunk
+} ArraySumJob;
+
+static double sum_strided(const uint8_t* p, uint32_t stride, uint64_t count) {
+    double sum = 0.0;
+    for (uint64_t i = 0; i < count; ++i, p += stride) {
+        double v;
+        memcpy(&v, p, sizeof(v));
+        sum += v;
+    }
+    return sum;
+}
+
+static void array_sum_chunk(uint64_t begin, uint64_t end, void* user_data) {
+    ArraySumJob* job = (ArraySumJob*)user_data;
+    job->partials[begin / ARRAY_SUM_GRAIN] = sum_strided(job->base + begin * job->stride, job->stride, end - begin);
+}
+
+static bool array_sum_execute(void* inst, ExecContext* ctx) {
+    (void)inst;
+    
+    if (!g_pin_handles) {
+        ctx->set_error(ctx, "Array pins require host API version 2");
+        return false;
+    }
+    
+    BufferView values;
+    double sum = 0.0;
+    uint64_t count = 0;
+    
+    if (ctx->get_input_buffer(ctx, ARRAY_SUM_PIN_VALUES, &values) && values.ptr) {
+        const uint8_t* base = (const uint8_t*)values.ptr;
+        uint64_t chunks = (values.len + ARRAY_SUM_GRAIN - 1) / ARRAY_SUM_GRAIN;
+        ArraySumJob job = {base, values.stride, NULL};
+        
+        if (values.len >= ARRAY_SUM_PARALLEL_MIN && g_host->parallel_for) {
+            job.partials = (double*)ctx->arena_alloc(ctx, chunks * sizeof(double), alignof(double));
+        }
+        
+        if (job.partials &&
+            g_host->parallel_for(0, values.len, ARRAY_SUM_GRAIN, array_sum_chunk, &job)) {
+            for (uint64_t i = 0; i < chunks; ++i) {
+                sum += job.partials[i];
+            }
+        } else {
+            sum = sum_strided(base, values.stride, values.len);
+        }
+        count = values.len;
+    }
+    
+    ctx->set_output_float_h(ctx, ARRAY_SUM_PIN_SUM, sum);
+    ctx->set_output_int_h(ctx, ARRAY_SUM_PIN_COUNT, (int64_t)count);
+    return true;
+}
+
+static NodeVTable array_sum_vtable = {
+    add_create,
+    add_destroy,
+    NULL, NULL,
+    NULL, NULL,
+    array_sum_execute,
+    NULL, NULL,
+    NULL, NULL,
+    NULL,
+    NULL            // execute_batch - array pins have no batch column type
+};
+
+static PinDesc array_sum_pins[] = {
+    {"Values", "array_f64", PIN_IN, PIN_KIND_DATA, 0},
+    {"Sum", "float", PIN_OUT, PIN_KIND_DATA, 0},
+    {"Count", "int", PIN_OUT, PIN_KIND_DATA, 0},
+};
+
+static NodeDesc array_sum_desc = {
+    "Array Sum",
+    "Math",
+    "com.rune.example.math.array_sum",
+    array_sum_pins,
+    3,
+    NODE_FLAG_PURE_DATA | NODE_FLAG_STATELESS | NODE_FLAG_THREAD_SAFE,
+    add_color,
+    NULL,
+    "Sum all elements of a numeric array"
+};
+
+/* ============================================================================
+ * Luau Bindings
+ *
+ * The same operations for scripts, as fast calls the VM invokes with unboxed
+ * numbers. divide follows Luau's own "/" (IEEE, no error on zero).
+ * ============================================================================ */
+
+static double luau_add(double a, double b) { return a + b; }
+static double luau_multiply(double a, double b) { return a * b; }
+static double luau_divide(double a, double b) { return a / b; }
+static double luau_power(double base, double exponent) { return pow(base, exponent); }
+
+static double luau_sum(const BufferView* values) {
+    return values->ptr ? sum_strided((const uint8_t*)values->ptr, values->stride, values->len) : 0.0;
+}
+
+static const struct {
+    const char*         name;
+    const char*         signature;
+    LuaFastcallFunction fn;
+} luau_functions[] = {
+    {"add", "dd->d", RUNE_FASTCALL_FN(luau_add)},
+    {"multiply", "dd->d", RUNE_FASTCALL_FN(luau_multiply)},
+    {"divide", "dd->d", RUNE_FASTCALL_FN(luau_divide)},
+    {"power", "dd->d", RUNE_FASTCALL_FN(luau_power)},
+    {"sum", "B->d", RUNE_FASTCALL_FN(luau_sum)},
+};
+
+// Registers the "rune_math" library; returns the number of functions bound
+static int register_luau(LuauRegistry* luau) {
+    if (!g_pin_handles || !luau || !luau->register_fastcall) {
+        return 0;  // No stack-based fallback: these exist for the fast path
+    }
+    void* L = luau->get_plugin_state("com.rune.example.math");
+    int bound = 0;
+    for (const auto& f : luau_functions) {
+        if (rune_luau_fastcall(g_host, luau, L, "rune_math", f.name, f.signature, f.fn)) {
+            bound++;
+        }
+    }
+    return bound;
+}
+
 /* ============================================================================
  * Plugin Lifecycle
  * ============================================================================ */
 
+static const RuneKernel math_kernel_variants[] = {
+#ifdef RUNE_ISA_HAS_AVX512
+    {RUNE_CPU_AVX512, &math_kernels_avx512},
+#endif
+#ifdef RUNE_ISA_HAS_AVX2
+    {RUNE_CPU_AVX2 | RUNE_CPU_FMA, &math_kernels_avx2},
+#endif
+    {0, &math_kernels_baseline},
+};
+
 static bool on_load(HostServices* host) {
     g_host = host;
+    g_pin_handles = RUNE_HOST_API_AT_LEAST(host, 2);
+    g_kernels = (const MathKernels*)rune_select_kernel(
+        rune_cpu_features(host), math_kernel_variants,
+        sizeof(math_kernel_variants) / sizeof(math_kernel_variants[0]));
     host->log(LOG_LEVEL_INFO, "Math plugin loaded");
     return true;
 }
 
 static void on_register(PluginNodeRegistry* reg, LuauRegistry* luau) {
-    (void)luau;
-    
     reg->register_node(&add_desc, &add_vtable);
     reg->register_node(&multiply_desc, &multiply_vtable);
     reg->register_node(&divide_desc, &divide_vtable);
-    reg->register_node(&power_desc, &power_vtable);
+    g_power_type = reg->register_node(&power_desc, &power_vtable);
+    
+    int registered = 4;
+    if (g_pin_handles) {
+        reg->register_node(&array_sum_desc, &array_sum_vtable);
+        registered++;
+    }
+    
+    int bound = register_luau(luau);
     
     if (g_host) {
-        g_host->log(LOG_LEVEL_INFO, "Math plugin registered 4 nodes");
+        RUNE_LOG_INFO(g_host, "Math plugin registered %d nodes and %d Luau functions", registered, bound);
     }
 }
 
 static void on_unload(void) {
+    MemoStats stats;
+    if (g_pin_handles && g_host->memo_get_stats && g_host->memo_get_stats(g_power_type, &stats)) {
+        RUNE_LOG_DEBUG(g_host, "Power memo: %llu hits, %llu misses",
+                       (unsigned long long)stats.hits, (unsigned long long)stats.misses);
+    }
+    
     if (g_host) {
         g_host->log(LOG_LEVEL_INFO, "Math plugin unloaded");
     }
     g_host = nullptr;
+    g_pin_handles = false;
+    g_power_type = 0;
+    g_kernels = &math_kernels_baseline;
 }
 
 static PluginAPI g_api = {
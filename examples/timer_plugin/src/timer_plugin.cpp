@@ -7,21 +7,58 @@
 
 #define NODEPLUG_BUILDING
 #include "rune_plugin.h"
+#include "rune_serialize.h"
 #include <cstring>
 #include <cstdlib>
 #include <stdexcept>
 
 static HostServices* g_host = nullptr;
+static bool g_api_v2 = false;
 
-// Helper: check if a given application environment flag is set to a truthy value.
-// This is used for crash-testing the host's plugin safety guards. In normal
-// operation these flags are unset, and the plugin behaves as usual.
-static bool IsTestFlagEnabled(HostServices* host, const char* key)
-{
-    if (!host || !host->app_env_get || !key)
-        return false;
+// Per-node-type instance pools. NULL when the host has no pool service, in
+// which case instances fall back to malloc/free.
+static ObjectPool* g_timer_pool = NULL;
+static ObjectPool* g_delay_pool = NULL;
+
+static const char* TEST_FLAG_THROW_IN_DELAY = "RUNE_TEST_TIMER_THROW_IN_DELAY_EXECUTE";
+static EnvKey g_key_throw_in_delay = ENV_KEY_INVALID;
+
+// Deferred log format for the per-run Delay message; 0 when the host has no
+// deferred logging, in which case RUNE_LOG_DEBUG is used instead.
+static uint32_t g_fmt_delay_started = 0;
+
+static void* instance_alloc(ObjectPool* pool, size_t size) {
+    return pool ? g_host->pool_alloc(pool) : malloc(size);
+}
 
-    const char* value = host->app_env_get(key);
+static void instance_free(ObjectPool* pool, void* ptr) {
+    if (pool) {
+        g_host->pool_free(pool, ptr);
+    } else {
+        free(ptr);
+    }
+}
+
+// Arms a host timer, preferring the microsecond timing-wheel API. Returns the
+// timer ID and whether the host will release it after one shot.
+static uint64_t arm_timer(uint32_t interval_ms, TimerMode mode, TimerCallback callback,
+                          void* user_data, bool* out_self_releasing) {
+    *out_self_releasing = false;
+
+    if (g_api_v2 && g_host->create_timer_ex) {
+        TimerDesc desc = {(uint64_t)interval_ms * 1000u, 0, mode, callback, user_data};
+        uint64_t id = g_host->create_timer_ex(&desc);
+        if (id) {
+            *out_self_releasing = (mode == TIMER_MODE_ONE_SHOT);
+            return id;
+        }
+    }
+
+    return g_host->create_timer(interval_ms, callback, user_data);
+}
+
+static bool IsTruthyFlagValue(const char* value)
+{
     if (!value || !value[0])
         return false;
 
@@ -34,18 +71,70 @@ static bool IsTestFlagEnabled(HostServices* host, const char* key)
     return false;
 }
 
+// Helper: check if a given application environment flag is set to a truthy value.
+// This is used for crash-testing the host's plugin safety guards. In normal
+// operation these flags are unset, and the plugin behaves as usual.
+static bool IsTestFlagEnabled(HostServices* host, const char* key)
+{
+    if (!host || !host->app_env_get || !key)
+        return false;
+
+    return IsTruthyFlagValue(host->app_env_get(key));
+}
+
+// Result of IsTestFlagEnabled for one key, valid while the application
+// environment generation is unchanged.
+typedef struct TestFlagCache {
+    uint64_t generation;
+    bool valid;
+    bool enabled;
+} TestFlagCache;
+
+static bool has_env_cache_api(HostServices* host)
+{
+    return RUNE_HOST_API_AT_LEAST(host, 2) && host->env_try_get_key && host->env_generation;
+}
+
+// Cached variant for hot paths: re-reads the variable only after the
+// application environment changed. key is an interned handle for name.
+static bool IsTestFlagEnabledCached(HostServices* host, EnvKey key, const char* name, TestFlagCache* cache)
+{
+    if (key == ENV_KEY_INVALID || !has_env_cache_api(host))
+        return IsTestFlagEnabled(host, name);
+
+    // Read the generation first, so a write racing with the lookup makes the
+    // next call refetch instead of keeping a stale value
+    uint64_t generation = host->env_generation(ENV_SCOPE_APP);
+    if (!cache->valid || cache->generation != generation) {
+        const char* value = NULL;
+        cache->enabled = host->env_try_get_key(ENV_SCOPE_APP, key, &value) && IsTruthyFlagValue(value);
+        cache->generation = generation;
+        cache->valid = true;
+    }
+    return cache->enabled;
+}
+
 /* ============================================================================
  * Timer Event Node
  * 
  * Fires at a configurable interval (in milliseconds).
  * ============================================================================ */
 
+/* Pin handles - indices into timer_pins */
+enum {
+    TIMER_PIN_INTERVAL   = 0,
+    TIMER_PIN_ON_TIMER   = 1,
+    TIMER_PIN_TICK_COUNT = 2,
+    TIMER_PIN_TICKS      = 3
+};
+
 typedef struct TimerInstance {
     uint64_t timer_id;
     ExecContext* ctx;
     bool active;
     uint32_t interval_ms;
     uint64_t tick_count;
+    bool restored;  // State came from deserialize_from or a clone (hot reload, fork)
 } TimerInstance;
 
 static void timer_callback(void* user_data) {
@@ -56,21 +145,36 @@ static void timer_callback(void* user_data) {
     
     inst->tick_count++;
     
-    // Set output values
+    if (g_api_v2) {
+        // This runs on a host timer thread, so hand the tick to the flow
+        // thread through the event queue. TickCount is the only output that
+        // changes, so it is the only value carried (and marked dirty). The
+        // host fills Ticks when timer_trigger_policy merges ticks.
+        EventValue tick;
+        tick.pin = TIMER_PIN_TICK_COUNT;
+        tick.type = PIN_TYPE_INT;
+        tick.value.i = (int64_t)inst->tick_count;
+        inst->ctx->post_event(inst->ctx, TIMER_PIN_ON_TIMER, &tick, 1);
+        return;
+    }
+    
+    // Set output values; version 1 hosts never merge ticks
     inst->ctx->set_output_int(inst->ctx, "TickCount", (int64_t)inst->tick_count);
+    inst->ctx->set_output_int(inst->ctx, "Ticks", 1);
     
     // Trigger the execution output
     inst->ctx->trigger_output(inst->ctx, "OnTimer");
 }
 
 static void* timer_create(void) {
-    TimerInstance* inst = (TimerInstance*)malloc(sizeof(TimerInstance));
+    TimerInstance* inst = (TimerInstance*)instance_alloc(g_timer_pool, sizeof(TimerInstance));
     if (inst) {
         inst->timer_id = 0;
         inst->ctx = NULL;
         inst->active = false;
         inst->interval_ms = 1000;
         inst->tick_count = 0;
+        inst->restored = false;
     }
     return inst;
 }
@@ -81,7 +185,7 @@ static void timer_destroy(void* inst_ptr) {
         if (inst->timer_id && g_host) {
             g_host->destroy_timer(inst->timer_id);
         }
-        free(inst);
+        instance_free(g_timer_pool, inst);
     }
 }
 
@@ -105,17 +209,23 @@ static bool timer_start_listening(void* inst_ptr, ExecContext* ctx) {
     // Store context for callback
     inst->ctx = ctx;
     inst->active = true;
-    inst->tick_count = 0;
+    
+    // A migrated or forked instance keeps counting from the state it was given
+    if (!inst->restored) {
+        inst->tick_count = 0;
+    }
+    inst->restored = false;
     
     // Create timer
-    inst->timer_id = g_host->create_timer(inst->interval_ms, timer_callback, inst);
+    bool self_releasing;
+    inst->timer_id = arm_timer(inst->interval_ms, TIMER_MODE_PERIODIC, timer_callback, inst, &self_releasing);
     
     if (inst->timer_id == 0) {
         g_host->log(LOG_LEVEL_ERROR, "Failed to create timer");
         return false;
     }
     
-    g_host->log_formatted(LOG_LEVEL_INFO, "Timer started with interval %u ms", inst->interval_ms);
+    RUNE_LOG_INFO(g_host, "Timer started with interval %u ms", inst->interval_ms);
     return true;
 }
 
@@ -134,6 +244,62 @@ static void timer_stop_listening(void* inst_ptr) {
     }
 }
 
+// Serialized state fields (rune_serialize.h); IDs are never reused
+enum {
+    TIMER_FIELD_INTERVAL_MS = 1,
+    TIMER_FIELD_TICK_COUNT  = 2
+};
+
+#define TIMER_STATE_VERSION 1
+
+static bool timer_serialize_to(void* inst_ptr, SerializeWriter* writer) {
+    TimerInstance* inst = (TimerInstance*)inst_ptr;
+    if (!inst) {
+        return false;
+    }
+    return rune_ser_write_header(writer, TIMER_STATE_VERSION) &&
+           rune_ser_write_u64(writer, TIMER_FIELD_INTERVAL_MS, inst->interval_ms) &&
+           rune_ser_write_u64(writer, TIMER_FIELD_TICK_COUNT, inst->tick_count);
+}
+
+static bool timer_deserialize_from(void* inst_ptr, const uint8_t* data, uint32_t size) {
+    TimerInstance* inst = (TimerInstance*)inst_ptr;
+    SerializeReader reader;
+    if (!inst || !rune_ser_read_init(&reader, data, size)) {
+        return false;
+    }
+    
+    SerializeField field;
+    uint32_t cursor = 0;
+    while (rune_ser_read_next(&reader, &cursor, &field)) {
+        switch (field.id) {
+            case TIMER_FIELD_INTERVAL_MS:
+                inst->interval_ms = (uint32_t)rune_ser_field_u64(&field, inst->interval_ms);
+                break;
+            case TIMER_FIELD_TICK_COUNT:
+                inst->tick_count = rune_ser_field_u64(&field, inst->tick_count);
+                break;
+            default:
+                break;  // Field from a newer version
+        }
+    }
+    inst->restored = true;
+    return true;
+}
+
+// Copy-on-write fork: copies the configuration and count. The clone is not
+// listening and keeps the count through its first start_listening.
+static void* timer_clone(const void* inst_ptr) {
+    const TimerInstance* src = (const TimerInstance*)inst_ptr;
+    TimerInstance* inst = src ? (TimerInstance*)timer_create() : NULL;
+    if (inst) {
+        inst->interval_ms = src->interval_ms;
+        inst->tick_count = src->tick_count;
+        inst->restored = true;
+    }
+    return inst;
+}
+
 static bool timer_execute(void* inst_ptr, ExecContext* ctx) {
     (void)inst_ptr;
     (void)ctx;
@@ -150,27 +316,43 @@ static NodeVTable timer_vtable = {
     NULL, NULL,     // on_pre_execute, on_post_execute
     timer_start_listening,
     timer_stop_listening,
-    NULL            // is_complete
+    NULL,           // is_complete
+    NULL,           // execute_batch
+    timer_serialize_to,
+    timer_deserialize_from,
+    timer_clone
 };
 
 static PinDesc timer_pins[] = {
     {"IntervalMs", "int", PIN_IN, PIN_KIND_DATA, 0},
     {"OnTimer", "execution", PIN_OUT, PIN_KIND_EXECUTION, 0},
     {"TickCount", "int", PIN_OUT, PIN_KIND_DATA, 0},
+    {"Ticks", "int", PIN_OUT, PIN_KIND_DATA, 0},  // Ticks merged into this run
 };
 
 static int timer_color[] = {200, 150, 100};
 
+// Short intervals, or a flow slower than its timer, would otherwise queue a
+// downstream run per tick. Cap each timer at 1 kHz and merge ticks that pile
+// up behind a running flow; Ticks tells the flow how many it stands for.
+static const TriggerPolicy timer_trigger_policy = {
+    1000,  // min_interval_us
+    0,     // max_batch
+    TIMER_PIN_TICKS
+};
+
 static NodeDesc timer_desc = {
     "Timer Event",
     "Events",
     "com.rune.example.timer.event",
     timer_pins,
-    3,
-    NODE_FLAG_TRIGGER_EVENT,
+    4,
+    NODE_FLAG_TRIGGER_EVENT | NODE_FLAG_REPORTS_CHANGES,
     timer_color,
     NULL,
-    "Fires at a configurable interval"
+    "Fires at a configurable interval",
+    NULL,  // ir
+    &timer_trigger_policy
 };
 
 /* ============================================================================
@@ -179,10 +361,19 @@ static NodeDesc timer_desc = {
  * Delays execution by a specified amount of time.
  * ============================================================================ */
 
+/* Pin handles - indices into delay_pins */
+enum {
+    DELAY_PIN_EXECUTE     = 0,
+    DELAY_PIN_DELAY_MS    = 1,
+    DELAY_PIN_ON_COMPLETE = 2
+};
+
 typedef struct DelayInstance {
     uint64_t timer_id;
     ExecContext* ctx;
     bool completed;
+    bool one_shot;  // Timer releases itself after firing
+    TestFlagCache throw_flag;
 } DelayInstance;
 
 static void delay_callback(void* user_data) {
@@ -191,24 +382,39 @@ static void delay_callback(void* user_data) {
         return;
     }
     
+    // Finish with the instance before reporting completion: once it is
+    // signalled the host may execute the node again (arming a new timer) or
+    // destroy it, so nothing below may touch inst.
+    ExecContext* ctx = inst->ctx;
+    uint64_t timer_id = inst->timer_id;
+    bool self_releasing = inst->one_shot;
+    inst->timer_id = 0;
     inst->completed = true;
     
-    // Trigger the execution output
-    inst->ctx->trigger_output(inst->ctx, "OnComplete");
+    // Destroy the timer unless the host already released it after one shot
+    if (timer_id && g_host && !self_releasing) {
+        g_host->destroy_timer(timer_id);
+    }
     
-    // Destroy the one-shot timer
-    if (inst->timer_id && g_host) {
-        g_host->destroy_timer(inst->timer_id);
-        inst->timer_id = 0;
+    // Trigger the execution output, then wake the parked node (API version 2
+    // hosts do not poll delay_is_complete for this node). This runs on a
+    // timer thread, so version 2 hosts get the trigger through post_event.
+    if (g_api_v2) {
+        ctx->post_event(ctx, DELAY_PIN_ON_COMPLETE, NULL, 0);
+        ctx->signal_complete(ctx, true);
+    } else {
+        ctx->trigger_output(ctx, "OnComplete");
     }
 }
 
 static void* delay_create(void) {
-    DelayInstance* inst = (DelayInstance*)malloc(sizeof(DelayInstance));
+    DelayInstance* inst = (DelayInstance*)instance_alloc(g_delay_pool, sizeof(DelayInstance));
     if (inst) {
         inst->timer_id = 0;
         inst->ctx = NULL;
         inst->completed = false;
+        inst->one_shot = false;
+        inst->throw_flag.valid = false;
     }
     return inst;
 }
@@ -219,7 +425,7 @@ static void delay_destroy(void* inst_ptr) {
         if (inst->timer_id && g_host) {
             g_host->destroy_timer(inst->timer_id);
         }
-        free(inst);
+        instance_free(g_delay_pool, inst);
     }
 }
 
@@ -232,7 +438,7 @@ static bool delay_execute(void* inst_ptr, ExecContext* ctx) {
     // Crash-testing hook for node execution: when the flag is enabled, this
     // node will deliberately throw so the host can confirm that plugin node
     // exceptions are contained and reported without crashing the app.
-    if (IsTestFlagEnabled(g_host, "RUNE_TEST_TIMER_THROW_IN_DELAY_EXECUTE")) {
+    if (IsTestFlagEnabledCached(g_host, g_key_throw_in_delay, TEST_FLAG_THROW_IN_DELAY, &inst->throw_flag)) {
         throw std::runtime_error("Timer plugin test exception in delay_execute");
     }
     
@@ -246,14 +452,20 @@ static bool delay_execute(void* inst_ptr, ExecContext* ctx) {
     inst->completed = false;
     
     // Create one-shot timer
-    inst->timer_id = g_host->create_timer((uint32_t)delay_ms, delay_callback, inst);
+    inst->timer_id = arm_timer((uint32_t)delay_ms, TIMER_MODE_ONE_SHOT, delay_callback, inst, &inst->one_shot);
     
     if (inst->timer_id == 0) {
         g_host->log(LOG_LEVEL_ERROR, "Failed to create delay timer");
         return false;
     }
     
-    g_host->log_formatted(LOG_LEVEL_DEBUG, "Delay started: %lld ms", (long long)delay_ms);
+#if RUNE_MIN_LOG_LEVEL <= 0
+    if (g_fmt_delay_started) {
+        g_host->log_deferred(g_fmt_delay_started, (long long)delay_ms);
+        return true;
+    }
+#endif
+    RUNE_LOG_DEBUG(g_host, "Delay started: %lld ms", (long long)delay_ms);
     return true;
 }
 
@@ -287,7 +499,7 @@ static NodeDesc delay_desc = {
     "com.rune.example.timer.delay",
     delay_pins,
     3,
-    NODE_FLAG_ASYNC,
+    NODE_FLAG_ASYNC | NODE_FLAG_SIGNALS_COMPLETION,
     delay_color,
     NULL,
     "Delays execution by specified milliseconds"
@@ -299,6 +511,7 @@ static NodeDesc delay_desc = {
 
 static bool on_load(HostServices* host) {
     g_host = host;
+    g_api_v2 = RUNE_HOST_API_AT_LEAST(host, 2);
 
     // Crash-testing hook: when RUNE_TEST_TIMER_THROW_ON_LOAD is set in the
     // application environment, deliberately throw here so the host can verify
@@ -307,6 +520,16 @@ static bool on_load(HostServices* host) {
         throw std::runtime_error("Timer plugin test exception in on_load");
     }
 
+    if (g_api_v2 && host->pool_create) {
+        g_timer_pool = host->pool_create(sizeof(TimerInstance), alignof(TimerInstance));
+        g_delay_pool = host->pool_create(sizeof(DelayInstance), alignof(DelayInstance));
+    }
+
+    if (has_env_cache_api(host) && host->env_key_intern) {
+        g_key_throw_in_delay = host->env_key_intern(TEST_FLAG_THROW_IN_DELAY);
+    }
+    g_fmt_delay_started = RUNE_LOG_FORMAT_REGISTER(host, LOG_LEVEL_DEBUG, "Delay started: %lld ms");
+
     host->log(LOG_LEVEL_INFO, "Timer plugin loaded");
     return true;
 }
@@ -318,8 +541,10 @@ static void on_register(PluginNodeRegistry* reg, LuauRegistry* luau) {
         throw std::runtime_error("Timer plugin test exception in on_register");
     }
 
-    reg->register_node(&timer_desc, &timer_vtable);
-    reg->register_node(&delay_desc, &delay_vtable);
+    // Replaces the previous build's types on a hot reload, so running
+    // timers carry over instead of stopping
+    rune_register_or_replace(g_host, reg, &timer_desc, &timer_vtable);
+    rune_register_or_replace(g_host, reg, &delay_desc, &delay_vtable);
     
     if (g_host) {
         g_host->log(LOG_LEVEL_INFO, "Timer plugin registered 2 nodes");
@@ -328,8 +553,19 @@ static void on_register(PluginNodeRegistry* reg, LuauRegistry* luau) {
 
 static void on_unload(void) {
     if (g_host) {
+        if (g_timer_pool) {
+            g_host->pool_destroy(g_timer_pool);
+        }
+        if (g_delay_pool) {
+            g_host->pool_destroy(g_delay_pool);
+        }
         g_host->log(LOG_LEVEL_INFO, "Timer plugin unloaded");
     }
+    g_timer_pool = NULL;
+    g_delay_pool = NULL;
+    g_fmt_delay_started = 0;
+    g_key_throw_in_delay = ENV_KEY_INVALID;
+    g_api_v2 = false;
     g_host = NULL;
 }
 
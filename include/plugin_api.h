@@ -47,7 +47,16 @@ extern "C" {
  * API Version
  * ========================================================================== */
 
-#define RUNE_PLUGIN_API_VERSION 1
+#define RUNE_PLUGIN_API_VERSION 2
+
+/*
+ * Version history:
+ *   1 - Initial ABI.
+ *   2 - Appends extension members to the end of ExecContext (and other structs
+ *       as noted). Members below an "API version 2" marker must only be read
+ *       when the other side reports api_version >= 2: plugins check
+ *       HostServices::api_version, hosts check PluginInfo::api_version.
+ */
 
 /* ==========================================================================
  * Forward declarations
@@ -85,9 +94,79 @@ typedef enum NodeFlags {
     NODE_FLAG_PURE_DATA      = 1 << 1,  /* No execution pins, only data flow */
     NODE_FLAG_ASYNC          = 1 << 2,  /* Can run asynchronously */
     NODE_FLAG_STATEFUL       = 1 << 3,  /* Maintains state between executions */
-    NODE_FLAG_HIDDEN         = 1 << 4   /* Not shown in node menu */
+    NODE_FLAG_HIDDEN         = 1 << 4,  /* Not shown in node menu */
+    NODE_FLAG_MEMOIZABLE     = 1 << 5,  /* Outputs depend only on inputs; host may cache them (API version 2) */
+    NODE_FLAG_REPORTS_CHANGES = 1 << 6, /* Node marks changed outputs itself (API version 2) */
+    NODE_FLAG_SIGNALS_COMPLETION = 1 << 7, /* Async node calls signal_complete; is_complete is not polled (API version 2) */
+    NODE_FLAG_STATELESS      = 1 << 8,  /* No per-instance data; instance lifecycle is skipped (API version 2) */
+    NODE_FLAG_THREAD_SAFE    = 1 << 9,  /* execute may run on a worker thread (API version 2) */
+    NODE_FLAG_MAIN_THREAD_ONLY = 1 << 10, /* Always runs on the main thread (API version 2) */
+    NODE_FLAG_IO_BOUND       = 1 << 11  /* Blocks on I/O; use with NODE_FLAG_THREAD_SAFE (API version 2) */
 } NodeFlags;
 
+/*
+ * Parallel branch execution (API version 2):
+ *   In parallel mode the host schedules independent branches of a flow's
+ *   graph as jobs on its worker pool (the workers behind submit_job), and a
+ *   node runs as soon as its inputs are ready. The flags decide where:
+ *   - NODE_FLAG_THREAD_SAFE: execute may run on any worker, concurrently
+ *     with other nodes, including other instances of the same type. One
+ *     instance never runs concurrently with itself, and its writes are
+ *     visible to its next call. Plugin globals that execute touches must be
+ *     read-only or synchronized.
+ *   - NODE_FLAG_MAIN_THREAD_ONLY: always runs on the main (UI) thread, e.g.
+ *     nodes whose state is shared with draw_inspector or draw_node_body.
+ *   - NODE_FLAG_IO_BOUND: execute is expected to block on files or the
+ *     network. Such nodes run on separate I/O workers so they do not hold
+ *     a compute worker.
+ *   Nodes with none of these flags run on the flow thread in graph order,
+ *   as in serial mode. The Threading Contract below lists what execute may
+ *   call on each of these threads.
+ */
+
+/*
+ * NODE_FLAG_STATELESS contract:
+ *   - Every callback works with inst == NULL. The host never calls
+ *     create_instance, destroy_instance, serialize or deserialize for the
+ *     type, keeps no per-instance record, and shares one dispatch entry
+ *     for the type across all flows.
+ *   - Version 1 hosts ignore the flag, so create_instance must still be
+ *     valid (returning NULL is fine).
+ *
+ * Copy-on-write forks (API version 2):
+ *   When a flow is forked (e.g. one template loaded for many tenants), the
+ *   copies share the template's instances. A copy gets its own instance
+ *   from NodeVTable::clone_instance just before its first call that can
+ *   change the state: execute, start_listening, deserialize or the
+ *   inspector. Types without clone_instance are copied eagerly at fork
+ *   time through create_instance and a serialize round trip.
+ */
+
+/*
+ * NODE_FLAG_MEMOIZABLE contract:
+ *   - Data outputs are a deterministic function of the data inputs and node
+ *     properties. The host may key a cache on the node type and a hash of
+ *     those values and replay cached outputs instead of calling execute.
+ *     Execution outputs still fire as after a successful execute.
+ *   - PIN_TYPE_PATH inputs are keyed on the path and the file's modification
+ *     time, so file-backed nodes stay correct when the file changes.
+ *   - Failed executions (execute returned false) are never cached.
+ * Capacity and eviction are configured per node type through
+ * HostServices::memo_configure; memo_get_stats reports hit/miss counters.
+ */
+
+/*
+ * Incremental evaluation (API version 2):
+ *   In incremental mode the host re-runs a data node only when one of its
+ *   inputs changed since its last run. By default an output counts as changed
+ *   when set_output_* stores a value different from the previous one; the
+ *   comparison happens inside that set_output_* call.
+ *   Nodes with NODE_FLAG_REPORTS_CHANGES skip that comparison: only outputs
+ *   passed to ExecContext::mark_output_dirty count as changed. Any node may
+ *   call ExecContext::outputs_unchanged to keep all data outputs at their
+ *   previous values without setting them again.
+ */
+
 /* ==========================================================================
  * Pin Types
  * ========================================================================== */
@@ -122,29 +201,145 @@ typedef uint64_t PinTypeId;
 #define PIN_TYPE_JSON      ((PinTypeId)5)
 #define PIN_TYPE_BLOB      ((PinTypeId)6)
 #define PIN_TYPE_PATH      ((PinTypeId)7)
+#define PIN_TYPE_ARRAY_F32 ((PinTypeId)8)   /* BufferView of float (API version 2) */
+#define PIN_TYPE_ARRAY_F64 ((PinTypeId)9)   /* BufferView of double (API version 2) */
+#define PIN_TYPE_ARRAY_I64 ((PinTypeId)10)  /* BufferView of int64_t (API version 2) */
 #define PIN_TYPE_EXECUTION ((PinTypeId)100)
 
 /* Custom pin types start at this ID */
 #define PIN_TYPE_CUSTOM_START ((PinTypeId)1000)
 
+/* Flags for PluginNodeRegistry::register_pin_type */
+typedef enum PinTypeFlags {
+    PIN_TYPE_FLAG_NONE   = 0,
+    PIN_TYPE_FLAG_BUFFER = 1 << 0   /* Values travel as BufferView; size is the element size (API version 2) */
+} PinTypeFlags;
+
+/* ==========================================================================
+ * Buffer View - Zero-copy numeric arrays for array and buffer pin types
+ *
+ * Buffers are reference counted by the host. Passing a view from an input to
+ * an output (or to another node) shares the memory instead of copying it.
+ * ========================================================================== */
+
+typedef struct BufferOwner BufferOwner;  /* Opaque, reference counted by the host */
+
+typedef struct BufferView {
+    void*        ptr;     /* First element */
+    uint64_t     len;     /* Number of elements */
+    uint32_t     stride;  /* Bytes between consecutive elements */
+    BufferOwner* owner;   /* Keeps ptr alive; NULL for memory the host must copy */
+} BufferView;
+
 /* ==========================================================================
  * Pin Description
  * ========================================================================== */
 
 typedef struct PinDesc {
-    const char*   name;       /* Display name of the pin */
-    const char*   type;       /* Type name: "string", "int", "float", "bool", "json", "execution", or custom */
+    const char*   name;       /* Display name of the pin (also used for name-based lookups) */
+    const char*   type;       /* Type name: "string", "int", "float", "bool", "json", "path", "array_f32",
+                                 "array_f64", "array_i64", "execution", or custom */
     PinDirection  direction;  /* PIN_IN or PIN_OUT */
     PinKind       kind;       /* PIN_KIND_DATA or PIN_KIND_EXECUTION */
     uint32_t      flags;      /* Combination of PinFlags */
 } PinDesc;
 
+/* ==========================================================================
+ * Pin Handle - Index-based pin addressing
+ *
+ * A pin handle is the index of the pin in its NodeDesc::pins array, so nodes
+ * may use compile-time constants instead of calling resolve_pin(). Handles
+ * are only meaningful for the node type that declared the pins.
+ * ========================================================================== */
+
+typedef uint32_t PinHandle;
+
+#define PIN_HANDLE_INVALID ((PinHandle)0xFFFFFFFFu)
+
 /* ==========================================================================
  * Node Type ID
  * ========================================================================== */
 
 typedef uint64_t NodeTypeId;
 
+/* ==========================================================================
+ * Node IR - Optional description of a pure-data node's computation
+ *
+ * Lets the host fuse connected NODE_FLAG_PURE_DATA nodes into one compiled
+ * kernel instead of dispatching execute per node. The IR is straight-line
+ * code over double registers:
+ *   - INPUT  loads data input pin `arg` (a PinHandle) into `dst`
+ *   - CONST  loads constants[arg] into `dst`
+ *   - arithmetic ops compute `dst` from registers `a` (and `b`)
+ *   - GUARD_NONZERO checks register `a`: if it is 0 the fused kernel stops
+ *     and the host runs the node through execute instead, so error cases
+ *     (e.g. division by zero) keep the plugin's own handling
+ *   - OUTPUT stores register `a` into data output pin `arg`
+ * The IR must compute exactly what execute does for all inputs that pass
+ * the guards. Hosts that do not understand ir->version ignore the IR.
+ * rune_ir_eval in rune_plugin.h is a reference interpreter for testing.
+ * ========================================================================== */
+
+#define NODE_IR_VERSION       1
+#define NODE_IR_MAX_REGISTERS 16
+
+typedef enum NodeIrOp {
+    NODE_IR_OP_INPUT         = 1,
+    NODE_IR_OP_CONST         = 2,
+    NODE_IR_OP_OUTPUT        = 3,
+    NODE_IR_OP_GUARD_NONZERO = 4,
+    NODE_IR_OP_ADD           = 10,  /* a + b */
+    NODE_IR_OP_SUB           = 11,  /* a - b */
+    NODE_IR_OP_MUL           = 12,  /* a * b */
+    NODE_IR_OP_DIV           = 13,  /* a / b */
+    NODE_IR_OP_POW           = 14,  /* pow(a, b) */
+    NODE_IR_OP_MIN           = 15,
+    NODE_IR_OP_MAX           = 16,
+    NODE_IR_OP_NEG           = 20,  /* -a */
+    NODE_IR_OP_ABS           = 21,
+    NODE_IR_OP_SQRT          = 22
+} NodeIrOp;
+
+typedef struct NodeIrInstr {
+    uint8_t  op;    /* NodeIrOp */
+    uint8_t  dst;   /* Destination register */
+    uint8_t  a;     /* Operand registers */
+    uint8_t  b;
+    uint32_t arg;   /* Pin handle (INPUT/OUTPUT) or constant index (CONST) */
+} NodeIrInstr;
+
+typedef struct NodeIr {
+    uint32_t           version;         /* NODE_IR_VERSION */
+    uint32_t           register_count;  /* At most NODE_IR_MAX_REGISTERS */
+    const NodeIrInstr* code;
+    uint32_t           code_count;
+    const double*      constants;       /* May be NULL when constant_count is 0 */
+    uint32_t           constant_count;
+} NodeIr;
+
+/* ==========================================================================
+ * Trigger Coalescing - Rate policy for NODE_FLAG_TRIGGER_EVENT nodes
+ *
+ * By default every trigger starts its own downstream run. With a policy the
+ * host merges a node's pending triggers of the same exec pin into one run:
+ *   - A trigger that arrives while the previous run started by this node is
+ *     still executing waits for it, merging with later arrivals.
+ *   - After a run starts, the next one starts no sooner than
+ *     min_interval_us later; triggers arriving in between merge.
+ *   - Once max_batch triggers are pending they fire without waiting out
+ *     min_interval_us.
+ * Data values carried by merged post_event calls are taken from the latest
+ * event. The host writes the number of triggers the run stands for to
+ * count_pin, an int data output, so downstream nodes can catch up.
+ * Triggers from trigger_output_batch count as that many triggers.
+ * ========================================================================== */
+
+typedef struct TriggerPolicy {
+    uint32_t  min_interval_us;  /* Minimum time between runs, 0 to only merge while busy */
+    uint32_t  max_batch;        /* Fire once this many are pending, 0 for no limit */
+    PinHandle count_pin;        /* Int output for the merged count, or PIN_HANDLE_INVALID */
+} TriggerPolicy;
+
 /* ==========================================================================
  * Node Description
  * ========================================================================== */
@@ -159,8 +354,67 @@ typedef struct NodeDesc {
     const int*      color;        /* Optional RGB color (3 ints), NULL for default */
     const char*     icon;         /* Optional icon name, NULL for default */
     const char*     description;  /* Optional description for tooltip */
+
+    /* ---- API version 2 ---------------------------------------------------- */
+
+    const NodeIr*   ir;           /* Optional, NODE_FLAG_PURE_DATA only (see Node IR) */
+    const TriggerPolicy* trigger_policy;  /* Optional, NODE_FLAG_TRIGGER_EVENT only */
 } NodeDesc;
 
+/* ==========================================================================
+ * String View - Non-owning string slices and interned strings
+ * ========================================================================== */
+
+/* Non-owning string slice, not NUL-terminated */
+typedef struct StringView {
+    const char* ptr;
+    size_t len;
+} StringView;
+
+/* Handle for a string in the host's interner (HostServices::intern) */
+typedef uint32_t StringId;
+
+#define STRING_ID_INVALID ((StringId)0)
+
+/* ==========================================================================
+ * Batch Context - Column-oriented inputs/outputs for batch execution
+ *
+ * Each column holds `count` contiguous values in the pin's native type:
+ *   "float" -> double, "int" -> int64_t, "bool" -> uint8_t (0 or 1)
+ * Columns are aligned to RUNE_BATCH_ALIGNMENT bytes. Execution pins and pins
+ * of other types have a NULL column; the host only batches nodes whose data
+ * pins all have a native column type.
+ * ========================================================================== */
+
+#define RUNE_BATCH_ALIGNMENT 64
+
+typedef struct BatchContext {
+    void* const*  columns;       /* One column per pin, indexed by PinHandle (inputs are read-only) */
+    uint32_t      column_count;  /* Equals NodeDesc::pin_count */
+    ExecContext*  ctx;           /* Context for set_error and host services */
+} BatchContext;
+
+/* ==========================================================================
+ * Serialize Writer - Appends node state to the flow's shared buffer
+ *
+ * The host keeps one buffer per flow save and passes the same writer to every
+ * node's serialize_to, so saving a flow is a single linear pass with no
+ * per-node allocations. Each node's data starts RUNE_SERIALIZE_ALIGNMENT
+ * aligned. The record layout is defined in rune_serialize.h.
+ * ========================================================================== */
+
+#define RUNE_SERIALIZE_ALIGNMENT 8
+
+typedef struct SerializeWriter SerializeWriter;
+
+struct SerializeWriter {
+    /* Append size bytes; returns false if the buffer could not grow */
+    bool (*append)(SerializeWriter* writer, const void* data, uint32_t size);
+
+    /* Opaque context data - do not modify */
+    void* _internal;
+};
+
 /* ==========================================================================
  * Node VTable - Functions implemented by the plugin for each node type
  * ========================================================================== */
@@ -191,9 +445,72 @@ typedef struct NodeVTable {
     
     /* Async node specific - poll for completion */
     bool (*is_complete)(void* inst);
-    
+
+    /* ---- API version 2 ---------------------------------------------------- */
+
+    /* Optional: evaluate `count` rows at once (NODE_FLAG_PURE_DATA nodes only).
+     * Returning false makes the host re-run the rows through execute() so
+     * errors are reported per row. */
+    bool (*execute_batch)(void* inst, const BatchContext* batch, uint32_t count);
+
+    /* Optional: state in the SDK binary format (see rune_serialize.h); used
+     * instead of serialize / deserialize when set. serialize_to appends to the
+     * flow's shared writer. deserialize_from reads in place from the flow
+     * file's bytes, which are only valid during the call - copy what must
+     * outlive it. */
+    bool (*serialize_to)(void* inst, SerializeWriter* writer);
+    bool (*deserialize_from)(void* inst, const uint8_t* data, uint32_t size);
+
+    /* Optional: new instance with a copy of inst's state, for copy-on-write
+     * forks (see NODE_FLAG_STATELESS above). Runtime resources such as
+     * armed timers or the ExecContext are not copied; the clone starts
+     * idle. Returns NULL on failure. */
+    void* (*clone_instance)(const void* inst);
+
 } NodeVTable;
 
+/* ==========================================================================
+ * Threading Contract
+ *
+ *   - PluginAPI callbacks, menu callbacks and NodeVTable draw_* hooks run on
+ *     the main thread.
+ *   - execute, execute_batch, on_pre_execute, on_post_execute,
+ *     start_listening, stop_listening and is_complete run on the thread
+ *     executing the flow (the "flow thread"). The host never enters one
+ *     instance from two threads at once.
+ *   - Parallel branch execution (see NodeFlags) is the exception: execute
+ *     of a NODE_FLAG_THREAD_SAFE or NODE_FLAG_IO_BOUND node may run on a
+ *     host worker thread, and execute of a NODE_FLAG_MAIN_THREAD_ONLY node
+ *     on the main thread. That thread then acts as the node's flow thread
+ *     for the duration of the call.
+ *   - Timer callbacks run on a host timer thread. Job functions and job
+ *     completion callbacks run on job worker threads.
+ *   - ExecContext members may only be used on the flow thread, during the
+ *     call that received the context (or, for event nodes, between
+ *     start_listening and stop_listening from flow-thread callbacks). For
+ *     a node executed on a worker or the main thread that means all
+ *     members, on that thread, until execute returns; afterwards the
+ *     context must not be used from it. Exceptions that are safe from any
+ *     thread: resolve_pin, post_event and signal_complete.
+ *   - HostServices members are thread-safe.
+ *
+ * Event nodes that fire from timer or I/O threads should use post_event.
+ * Version 1 style set_output_* / trigger_output calls from such threads
+ * are still accepted, but the host serializes them behind a lock.
+ * ========================================================================== */
+
+/* A data output value carried by a posted event */
+typedef struct EventValue {
+    PinHandle pin;   /* Data output pin */
+    PinTypeId type;  /* PIN_TYPE_INT, PIN_TYPE_FLOAT, PIN_TYPE_BOOL or PIN_TYPE_STRING */
+    union {
+        int64_t     i;
+        double      f;
+        bool        b;
+        const char* s;  /* Copied by the host */
+    } value;
+} EventValue;
+
 /* ==========================================================================
  * Execution Context - Passed to node execution
  * ========================================================================== */
@@ -227,6 +544,82 @@ struct ExecContext {
     
     /* Opaque context data - do not modify */
     void* _internal;
+
+    /* ---- API version 2 ---------------------------------------------------- */
+
+    /* Resolve a pin name to its handle (PIN_HANDLE_INVALID if not found) */
+    PinHandle (*resolve_pin)(ExecContext* ctx, const char* pin_name);
+
+    /* Get input value by pin handle */
+    const char* (*get_input_string_h)(ExecContext* ctx, PinHandle pin);
+    int64_t     (*get_input_int_h)(ExecContext* ctx, PinHandle pin);
+    double      (*get_input_float_h)(ExecContext* ctx, PinHandle pin);
+    bool        (*get_input_bool_h)(ExecContext* ctx, PinHandle pin);
+    const char* (*get_input_json_h)(ExecContext* ctx, PinHandle pin);
+
+    /* Set output value by pin handle */
+    void (*set_output_string_h)(ExecContext* ctx, PinHandle pin, const char* value);
+    void (*set_output_int_h)(ExecContext* ctx, PinHandle pin, int64_t value);
+    void (*set_output_float_h)(ExecContext* ctx, PinHandle pin, double value);
+    void (*set_output_bool_h)(ExecContext* ctx, PinHandle pin, bool value);
+    void (*set_output_json_h)(ExecContext* ctx, PinHandle pin, const char* json_str);
+
+    /* Trigger execution output by pin handle */
+    void (*trigger_output_h)(ExecContext* ctx, PinHandle exec_pin);
+
+    /* Buffer pins (PIN_TYPE_ARRAY_* and PIN_TYPE_FLAG_BUFFER types).
+     * Input views are borrowed for the duration of execute(); retain the owner
+     * to keep one longer. set_output_buffer retains view->owner itself. */
+    bool (*get_input_buffer)(ExecContext* ctx, PinHandle pin, BufferView* out_view);
+    void (*set_output_buffer)(ExecContext* ctx, PinHandle pin, const BufferView* view);
+
+    /* Scratch memory scoped to the current flow run. It is released in bulk
+     * when the run finishes - never free it. Returns NULL on exhaustion. */
+    void* (*arena_alloc)(ExecContext* ctx, size_t size, size_t align);
+
+    /* Change tracking for incremental evaluation (see NODE_FLAG_REPORTS_CHANGES).
+     * Valid during execute and when triggering from an event node. */
+    void (*mark_output_dirty)(ExecContext* ctx, PinHandle pin);
+    void (*outputs_unchanged)(ExecContext* ctx);
+
+    /* Completion notification for NODE_FLAG_ASYNC nodes. The host parks a
+     * NODE_FLAG_SIGNALS_COMPLETION node after execute and wakes it only when
+     * this is called. Safe to call from any thread (including from within
+     * execute itself), exactly once per execute. */
+    void (*signal_complete)(ExecContext* ctx, bool success);
+
+    /* Queue a trigger from any thread with a single lock-free push onto the
+     * host's multi-producer event queue. The host drains the queue on the
+     * flow thread in batches: it stores the values in their data outputs
+     * (they count as dirty outputs) and then fires exec_pin, merging events
+     * as the node's TriggerPolicy allows. Returns false if the queue is full
+     * and the event was dropped. */
+    bool (*post_event)(ExecContext* ctx, PinHandle exec_pin,
+                       const EventValue* values, uint32_t value_count);
+
+    /* Strings without strlen or NUL-terminated copies.
+     *   get_input_string_view: borrowed view of a string input, valid for
+     *     the duration of execute(). Not NUL-terminated. Returns false (and
+     *     an empty view) if the pin is not a string input.
+     *   set_output_string_view: copies value.len bytes; value may be a slice
+     *     of a larger buffer.
+     *   set_output_string_borrowed: stores the pointer without copying. The
+     *     bytes must stay valid and unchanged until the next set of this pin
+     *     returns (the host compares the new value against the previous one
+     *     as it is set, see Incremental evaluation) or the node is destroyed:
+     *     static strings, intern() results and memory the instance owns
+     *     qualify, as does arena_alloc memory (the host copies borrowed
+     *     values it keeps past the end of the run, such as memoized
+     *     outputs). Release memory behind a replaced value only after
+     *     setting the new one. */
+    bool (*get_input_string_view)(ExecContext* ctx, PinHandle pin, StringView* out_view);
+    void (*set_output_string_view)(ExecContext* ctx, PinHandle pin, StringView value);
+    void (*set_output_string_borrowed)(ExecContext* ctx, PinHandle pin, StringView value);
+
+    /* Fire exec_pin once on behalf of count events (count >= 1), e.g. when
+     * an event node drains several queued items itself. Downstream sees one
+     * run; the node's TriggerPolicy::count_pin receives count. */
+    void (*trigger_output_batch)(ExecContext* ctx, PinHandle exec_pin, uint32_t count);
 };
 
 /* ==========================================================================
@@ -237,9 +630,91 @@ typedef struct JobHandle {
     uint64_t id;
 } JobHandle;
 
+/* Timeout for HostServices::wait_job that never expires */
+#define RUNE_WAIT_INFINITE 0xFFFFFFFFu
+
 typedef void (*JobFunction)(void* user_data);
 typedef void (*JobCompletionCallback)(void* user_data, bool success);
 
+typedef enum JobPriority {
+    JOB_PRIORITY_LOW    = 0,  /* Background work, runs when workers are idle */
+    JOB_PRIORITY_NORMAL = 1,  /* Default for submit_job */
+    JOB_PRIORITY_HIGH   = 2   /* Latency-sensitive work, runs ahead of queued jobs */
+} JobPriority;
+
+typedef struct JobDesc {
+    JobFunction           fn;
+    void*                 user_data;
+    JobCompletionCallback on_complete;  /* Optional */
+    JobPriority           priority;
+} JobDesc;
+
+/* Processes items [begin, end) of a parallel_for range */
+typedef void (*ParallelForFunction)(uint64_t begin, uint64_t end, void* user_data);
+
+/* ==========================================================================
+ * Timer Types
+ * ========================================================================== */
+
+typedef void (*TimerCallback)(void* user_data);
+
+typedef enum TimerMode {
+    TIMER_MODE_PERIODIC = 0,  /* Fires every interval until destroyed */
+    TIMER_MODE_ONE_SHOT = 1   /* Fires once, then releases itself */
+} TimerMode;
+
+typedef struct TimerDesc {
+    uint64_t      interval_us;  /* Period, or delay for one-shot timers, in microseconds */
+    uint64_t      slack_us;     /* Allowed lateness; timers due within each other's slack fire together */
+    TimerMode     mode;
+    TimerCallback callback;
+    void*         user_data;
+} TimerDesc;
+
+/* ==========================================================================
+ * Object Pool - Fixed-size allocations (e.g. node instances)
+ * ========================================================================== */
+
+typedef struct ObjectPool ObjectPool;  /* Opaque, owned by the host */
+
+/* ==========================================================================
+ * Memoization - Output cache for NODE_FLAG_MEMOIZABLE nodes
+ * ========================================================================== */
+
+typedef enum MemoEviction {
+    MEMO_EVICT_LRU = 0,  /* Evict the least recently used entry */
+    MEMO_EVICT_LFU = 1   /* Evict the least frequently used entry */
+} MemoEviction;
+
+typedef struct MemoStats {
+    uint64_t hits;       /* Executions answered from the cache */
+    uint64_t misses;     /* Executions that ran execute() */
+    uint64_t evictions;  /* Entries dropped to stay within capacity */
+    uint32_t entries;    /* Entries currently cached */
+    uint32_t capacity;   /* Maximum number of entries */
+} MemoStats;
+
+/* ==========================================================================
+ * Profiling - Per-node execution statistics
+ * ========================================================================== */
+
+typedef struct NodeProfileStats {
+    uint64_t call_count;   /* Executions recorded */
+    uint64_t total_ns;     /* Time in on_pre_execute + execute + on_post_execute */
+    uint64_t host_ns;      /* Part of total_ns spent inside HostServices calls */
+    uint64_t p50_ns;       /* Median execution latency */
+    uint64_t p99_ns;       /* 99th percentile execution latency */
+    uint64_t max_ns;       /* Slowest execution */
+    uint64_t alloc_bytes;  /* Bytes allocated through host allocators, arenas, pools and buffers */
+} NodeProfileStats;
+
+/* ==========================================================================
+ * JSON Handles - Parsed documents and compiled paths
+ * ========================================================================== */
+
+typedef struct JsonDoc JsonDoc;    /* Opaque parsed document, owned by the host */
+typedef struct JsonPath JsonPath;  /* Opaque compiled path, owned by the host */
+
 /* ==========================================================================
  * CSV Data Types
  * ========================================================================== */
@@ -254,12 +729,90 @@ typedef struct CsvData {
     uint32_t row_count;
 } CsvData;
 
+typedef struct CsvReader CsvReader;  /* Opaque streaming reader, owned by the host */
+
+typedef enum CsvBatchFlags {
+    CSV_BATCH_FLAG_NONE    = 0,
+    CSV_BATCH_FLAG_ESCAPED = 1 << 0   /* Some quoted cells still contain doubled ("") quotes */
+} CsvBatchFlags;
+
+typedef struct CsvBatch {
+    const StringView* cells;        /* Cells of all rows in the batch, row-major */
+    const uint32_t*   row_offsets;  /* row_count + 1 entries: row i is cells[row_offsets[i]..row_offsets[i + 1]) */
+    uint32_t          row_count;
+    uint32_t          flags;        /* Combination of CsvBatchFlags */
+} CsvBatch;
+
+/* ==========================================================================
+ * INI Handle - Parsed document with an indexed section/key lookup
+ * ========================================================================== */
+
+typedef struct IniDoc IniDoc;  /* Opaque parsed document, owned by the host */
+
+/* ==========================================================================
+ * Environment Keys - Interned variable names for cached lookups
+ * ========================================================================== */
+
+typedef uint32_t EnvKey;
+
+#define ENV_KEY_INVALID ((EnvKey)0)
+
+typedef enum EnvScope {
+    ENV_SCOPE_FLOW = 0,  /* Flow environment, as read by env_get / flow_env_get */
+    ENV_SCOPE_APP  = 1   /* Application environment (app_env_*) */
+} EnvScope;
+
+/* ==========================================================================
+ * Typed Settings - Pre-parsed plugin settings
+ *
+ * A plugin lists the settings it reads in PluginSettingsSchema::fields. The
+ * host validates each settings change against the schema once, converts every
+ * field to its declared type and hands the plugin a SettingsView. A field's
+ * ID is its index in the fields array.
+ * ========================================================================== */
+
+typedef enum SettingsFieldType {
+    SETTINGS_FIELD_BOOL   = 0,
+    SETTINGS_FIELD_INT    = 1,
+    SETTINGS_FIELD_FLOAT  = 2,
+    SETTINGS_FIELD_STRING = 3
+} SettingsFieldType;
+
+typedef struct SettingsField {
+    const char*       path;  /* Property path in the settings JSON (json_parse syntax) */
+    SettingsFieldType type;
+} SettingsField;
+
+typedef struct SettingsView SettingsView;  /* Opaque, immutable snapshot owned by the host */
+
+/* ==========================================================================
+ * CPU Features - Bits returned by HostServices::get_cpu_features
+ *
+ * A bit is set only when both the CPU and the OS support the extension
+ * (e.g. AVX state is saved on context switch), so a kernel compiled for it
+ * is safe to call. See rune_select_kernel in rune_plugin.h.
+ * ========================================================================== */
+
+#define RUNE_CPU_SSE4_2    (1ull << 0)
+#define RUNE_CPU_AVX       (1ull << 1)
+#define RUNE_CPU_AVX2      (1ull << 2)
+#define RUNE_CPU_FMA       (1ull << 3)
+#define RUNE_CPU_AVX512F   (1ull << 4)
+#define RUNE_CPU_AVX512BW  (1ull << 5)
+#define RUNE_CPU_AVX512DQ  (1ull << 6)
+#define RUNE_CPU_AVX512VL  (1ull << 7)
+#define RUNE_CPU_NEON      (1ull << 16)
+
+/* What the "avx512" variant of rune_add_plugin_isa_variants is built for */
+#define RUNE_CPU_AVX512 \
+    (RUNE_CPU_AVX512F | RUNE_CPU_AVX512BW | RUNE_CPU_AVX512DQ | RUNE_CPU_AVX512VL)
+
 /* ==========================================================================
  * Host Services - Provided by RUNE to plugins
  * ========================================================================== */
 
 struct HostServices {
-    uint32_t api_version;
+    uint32_t api_version;  /* RUNE_PLUGIN_API_VERSION implemented by the host */
     
     /* Logging */
     void (*log)(PluginLogLevel level, const char* message);
@@ -325,10 +878,205 @@ struct HostServices {
     
     /* RUNE settings (read-only global app config) */
     const char* (*get_rune_setting)(const char* setting_name);
+
+    /* ---- API version 2 ---------------------------------------------------- */
+    /* Optional services: each member is NULL when the host does not provide it */
+
+    /* Buffers for array pins. buffer_create allocates len elements of
+     * element_size bytes (RUNE_BATCH_ALIGNMENT aligned) with a reference
+     * count of 1; buffer_release frees the memory when the count drops to 0. */
+    bool (*buffer_create)(uint32_t element_size, uint64_t len, BufferView* out_view);
+    void (*buffer_retain)(BufferOwner* owner);
+    void (*buffer_release)(BufferOwner* owner);
+
+    /* Fixed-size object pools, typically one per node type for
+     * create_instance. Pools are thread-safe; pool_destroy releases any
+     * objects still allocated from the pool. */
+    ObjectPool* (*pool_create)(uint32_t object_size, uint32_t align);
+    void*       (*pool_alloc)(ObjectPool* pool);
+    void        (*pool_free)(ObjectPool* pool, void* ptr);
+    void        (*pool_destroy)(ObjectPool* pool);
+
+    /* Parsed JSON documents: parse once, query many times. Paths use the same
+     * syntax as json_parse. json_doc_open returns NULL for invalid JSON;
+     * json_doc_query returns NULL when the path does not match, otherwise a
+     * string owned by the document and valid until json_doc_close. Compiled
+     * paths are immutable and may be shared between threads and documents. */
+    JsonDoc*    (*json_doc_open)(const char* json_str, size_t len);
+    void        (*json_doc_close)(JsonDoc* doc);
+    JsonPath*   (*json_path_compile)(const char* json_path);
+    void        (*json_path_free)(JsonPath* path);
+    const char* (*json_doc_query)(JsonDoc* doc, const JsonPath* path);
+
+    /* Streaming CSV reader. Cells are slices into the source data, which must
+     * outlive the reader. Quoted cells exclude the enclosing quotes but keep
+     * doubled quotes as-is (see CSV_BATCH_FLAG_ESCAPED). Batch arrays stay
+     * valid until the next csv_reader_next_batch or csv_reader_close call.
+     * csv_reader_next_batch returns false once no rows remain.
+     * csv_count_rows counts rows the same way without producing cells. */
+    CsvReader* (*csv_reader_open)(const char* data, size_t len, char delimiter);
+    bool       (*csv_reader_next_batch)(CsvReader* reader, uint32_t max_rows, CsvBatch* out_batch);
+    void       (*csv_reader_close)(CsvReader* reader);
+    uint64_t   (*csv_count_rows)(const char* data, size_t len, char delimiter);
+
+    /* Memory-mapped file input (mmap on POSIX, MapViewOfFile on Windows).
+     * Paths are resolved like PIN_TYPE_PATH values. file_map returns a
+     * read-only byte view (stride 1); releasing its owner unmaps the file.
+     * The *_mapped variants keep the mapping alive for the lifetime of the
+     * returned reader or document. All return NULL/false on failure. */
+    bool       (*file_map)(const char* path, BufferView* out_view);
+    CsvReader* (*csv_reader_open_mapped)(const char* path, char delimiter);
+    JsonDoc*   (*json_doc_open_mapped)(const char* path);
+
+    /* Parsed INI documents with a hashed section/key index.
+     * ini_doc_get returns a value owned by the document, valid until that key
+     * is set again or the document is closed. The iterators do not allocate:
+     * start *cursor at 0 and call until they return false; the returned views
+     * point into the document. ini_doc_set updates the index in place, and
+     * ini_doc_serialize produces INI text only when needed (release it with
+     * HostServices::free). */
+    IniDoc*     (*ini_doc_open)(const char* ini_str, size_t len);
+    IniDoc*     (*ini_doc_open_mapped)(const char* path);
+    void        (*ini_doc_close)(IniDoc* doc);
+    const char* (*ini_doc_get)(const IniDoc* doc, const char* section, const char* key);
+    bool        (*ini_doc_next_section)(const IniDoc* doc, uint32_t* cursor, StringView* out_section);
+    bool        (*ini_doc_next_key)(const IniDoc* doc, const char* section, uint32_t* cursor,
+                                    StringView* out_key, StringView* out_value);
+    bool        (*ini_doc_set)(IniDoc* doc, const char* section, const char* key, const char* value);
+    char*       (*ini_doc_serialize)(const IniDoc* doc);
+
+    /* Output cache for NODE_FLAG_MEMOIZABLE node types. A capacity of 0
+     * disables caching for the type; memo_clear drops all of its entries. */
+    void (*memo_configure)(NodeTypeId type_id, uint32_t capacity, MemoEviction eviction);
+    bool (*memo_get_stats)(NodeTypeId type_id, MemoStats* out_stats);
+    void (*memo_clear)(NodeTypeId type_id);
+
+    /* Work-stealing task scheduler. Handles returned here work with poll_job
+     * and cancel_job, and may be used as dependencies.
+     *   submit_job_group: the group handle completes once every job in it has
+     *     finished; on_group_complete then runs once (success is false if any
+     *     job was cancelled).
+     *   submit_job_after: the job starts only after all deps have completed.
+     *   parallel_for: splits [begin, end) into chunks starting at
+     *     begin + k * grain of at most grain items, runs them on the workers
+     *     and the calling thread, and returns once all chunks are done. */
+    JobHandle (*submit_job_ex)(const JobDesc* job);
+    JobHandle (*submit_job_group)(const JobDesc* jobs, uint32_t count,
+                                  JobCompletionCallback on_group_complete, void* user_data);
+    JobHandle (*submit_job_after)(const JobDesc* job, const JobHandle* deps, uint32_t dep_count);
+    bool      (*parallel_for)(uint64_t begin, uint64_t end, uint64_t grain,
+                              ParallelForFunction fn, void* user_data);
+    uint32_t  (*get_worker_count)(void);
+
+    /* Block until a job (or group) completes or timeout_ms elapses. Returns
+     * true if it completed. Never call from a job running on a worker with
+     * RUNE_WAIT_INFINITE for a job that may be queued behind it. */
+    bool (*wait_job)(JobHandle handle, uint32_t timeout_ms);
+
+    /* Hierarchical timing-wheel timers with O(1) arm and cancel. Returns a
+     * timer ID for destroy_timer (0 on failure). IDs are never reused, so
+     * destroying an expired one-shot timer is a harmless no-op. Once
+     * destroy_timer returns, the callback is neither running nor will run
+     * again (unless destroy_timer was called from that callback). */
+    uint64_t (*create_timer_ex)(const TimerDesc* desc);
+
+    /* Profiler. While enabled, the host times each node's on_pre_execute /
+     * execute / on_post_execute per node type and per instance.
+     * profile_scope_begin opens a named sub-span on the calling thread and
+     * returns a token for profile_scope_end (0 when not recording). The host
+     * keys spans by the name pointer, so pass a string literal.
+     * profile_get_instance_stats reports the instance executing with ctx.
+     * profile_export_trace writes Chrome trace / Perfetto JSON. */
+    bool     (*profile_is_enabled)(void);
+    uint64_t (*profile_scope_begin)(const char* name);
+    void     (*profile_scope_end)(uint64_t scope);
+    bool     (*profile_get_node_stats)(NodeTypeId type_id, NodeProfileStats* out_stats);
+    bool     (*profile_get_instance_stats)(ExecContext* ctx, NodeProfileStats* out_stats);
+    bool     (*profile_export_trace)(const char* path);
+
+    /* Log filtering. get_log_level returns the lowest level the host
+     * currently records, and is_log_enabled(level) is the same check as a
+     * predicate. The level can change at runtime, so query it per message
+     * rather than caching it (see RUNE_LOG_* in rune_plugin.h). */
+    PluginLogLevel (*get_log_level)(void);
+    bool           (*is_log_enabled)(PluginLogLevel level);
+
+    /* Deferred logging. log_register_format registers a printf-style format
+     * once and returns its ID (0 on failure); the format must stay valid
+     * until the plugin unloads, so pass a string literal. log_deferred copies
+     * the arguments described by the format's conversions into a binary
+     * record without formatting them (%s strings are copied, %n is not
+     * supported). The host formats records only when they are displayed or
+     * exported, and drops records below the current log level up front. */
+    uint32_t (*log_register_format)(PluginLogLevel level, const char* format);
+    void     (*log_deferred)(uint32_t format_id, ...);
+
+    /* Cached environment and settings access.
+     *   env_try_get: one lookup instead of *_has + *_get. Returns false if
+     *     the variable is unset; otherwise stores its value, which stays
+     *     valid until the variable is next written.
+     *   env_key_intern: stable handle for a variable name (the same name
+     *     always yields the same key); env_try_get_key skips hashing it.
+     *   env_generation: increases whenever a variable in the scope is set
+     *     or removed. A value fetched after reading generation G is current
+     *     for as long as the scope still reports G.
+     *   settings_generation: the same for get_plugin_settings (any plugin)
+     *     and get_rune_setting values. */
+    bool     (*env_try_get)(EnvScope scope, const char* key, const char** out_value);
+    EnvKey   (*env_key_intern)(const char* key);
+    bool     (*env_try_get_key)(EnvScope scope, EnvKey key, const char** out_value);
+    uint64_t (*env_generation)(EnvScope scope);
+    uint64_t (*settings_generation)(void);
+
+    /* Typed settings views. Values of fields missing from the settings fall
+     * back to defaults_json, then to false / 0 / 0.0 / "". Reading a field as
+     * another type than declared returns that fallback too.
+     * settings_get_string never returns NULL; its result lives as long as the
+     * view. get_settings_view returns the current view of a plugin that
+     * declared fields (NULL otherwise); a view stays valid until the end of
+     * the callback or flow run in which it was obtained. */
+    const SettingsView* (*get_settings_view)(const char* plugin_id);
+    bool                (*settings_get_bool)(const SettingsView* view, uint32_t field_id);
+    int64_t             (*settings_get_int)(const SettingsView* view, uint32_t field_id);
+    double              (*settings_get_float)(const SettingsView* view, uint32_t field_id);
+    const char*         (*settings_get_string)(const SettingsView* view, uint32_t field_id);
+
+    /* String interner. intern returns the same id for equal strings (never
+     * STRING_ID_INVALID). Interned strings are NUL-terminated and live until
+     * the host exits, so intern_lookup views can be passed to
+     * set_output_string_borrowed and compared by id. Intern bounded sets of
+     * values only - keys, setting names, categories - not arbitrary data.
+     * intern_lookup returns an empty view for unknown ids. */
+    StringId   (*intern)(const char* str, size_t len);
+    StringView (*intern_lookup)(StringId id);
+
+    /* RUNE_CPU_* bits of the machine, detected once at host startup. Cheap
+     * to call, unlike has_capability, which is for host features. */
+    uint64_t (*get_cpu_features)(void);
 };
 
 /* ==========================================================================
  * Node Registry - For registering nodes and pin types
+ *
+ * Hot reload (API version 2): the host loads the rebuilt library next to the
+ * running one and calls its on_load and on_register. Node types that are
+ * already registered are swapped in place with replace_node
+ * (rune_register_or_replace does this), without stopping any flow:
+ *   1. The new desc and vtable are published at once. Executions that start
+ *      afterwards use them; calls already running finish on the old code.
+ *   2. Each instance is migrated in the background between executions (an
+ *      async node counts as executing until it completes): old
+ *      serialize_to (or serialize), new create, new deserialize_from (or
+ *      deserialize). Instances whose old code cannot serialize start from
+ *      defaults.
+ *   3. Listening instances are made before they are broken: the new
+ *      instance's start_listening runs before the old one's stop_listening,
+ *      and triggers the old instance raises after that are dropped.
+ *   4. The old instance is destroyed with the old vtable. Once no thread can
+ *      still be inside the old library (an epoch grace period), the host
+ *      calls its on_unload and unloads it.
+ * Pins are matched by name when the new desc changes them; links to pins
+ * that no longer exist are removed.
  * ========================================================================== */
 
 struct PluginNodeRegistry {
@@ -343,6 +1091,17 @@ struct PluginNodeRegistry {
     
     /* Get built-in pin type ID by name */
     PinTypeId (*get_pin_type_id)(const char* type_name);
+
+    /* ---- API version 2 ---------------------------------------------------- */
+    /* Optional: NULL when the host does not support hot reload */
+
+    /* Node type registered under NodeDesc::unique_name, or 0 */
+    NodeTypeId (*find_node)(const char* unique_name);
+
+    /* Swap a registered type's desc and vtable (see Hot reload above). Never
+     * blocks on running flows. Returns false if type_id is unknown or
+     * desc->unique_name differs from the registered type's. */
+    bool (*replace_node)(NodeTypeId type_id, const NodeDesc* desc, const NodeVTable* vtbl);
 };
 
 
@@ -352,6 +1111,27 @@ struct PluginNodeRegistry {
 
 typedef int (*LuaCFunction)(void* L);
 
+/*
+ * Fast calls (API version 2):
+ *   register_fastcall binds a native function the VM calls directly with
+ *   unboxed arguments, skipping the Luau stack. The signature string gives
+ *   the C prototype as argument codes, "->", and an optional result code:
+ *     d  double            Luau number
+ *     i  int64_t           Luau number, truncated toward zero
+ *     b  bool              Luau boolean
+ *     B  const BufferView* Luau buffer or array pin value, read as doubles;
+ *                          borrowed for the duration of the call (argument only)
+ *   e.g. "dd->d" is double (*)(double, double) and "B->d" is
+ *   double (*)(const BufferView*). At most RUNE_LUAU_FASTCALL_MAX_ARGS
+ *   arguments. The VM checks argument types before the call and raises a
+ *   script error on a mismatch, so fn never sees a wrong type. fn cannot
+ *   raise errors or call back into Luau and may run on any thread that
+ *   runs this plugin's scripts.
+ */
+#define RUNE_LUAU_FASTCALL_MAX_ARGS 4
+
+typedef void (*LuaFastcallFunction)(void);  /* Cast to and from the real prototype */
+
 struct LuauRegistry {
     /* Get the Luau state for this plugin (isolated environment) */
     void* (*get_plugin_state)(const char* plugin_id);
@@ -365,6 +1145,14 @@ struct LuauRegistry {
     
     /* Set sandbox policy for this plugin's Luau state */
     void (*set_sandbox_policy)(void* L, const char* policy_name);
+
+    /* ---- API version 2 ---------------------------------------------------- */
+
+    /* Register a typed native function (see Fast calls above) in library
+     * lib_name, or as a global when lib_name is NULL. Returns false if the
+     * signature is not supported; fall back to a LuaCFunction then. */
+    bool (*register_fastcall)(void* L, const char* lib_name, const char* name,
+                              const char* signature, LuaFastcallFunction fn);
 };
 
 /* ==========================================================================
@@ -374,6 +1162,11 @@ struct LuauRegistry {
 typedef struct PluginSettingsSchema {
     const char* schema_json;   /* JSON schema defining settings structure */
     const char* defaults_json; /* Default values as JSON */
+
+    /* ---- API version 2 ---------------------------------------------------- */
+
+    const SettingsField* fields;  /* Optional typed fields, see SettingsView; field ID = index */
+    uint32_t field_count;
 } PluginSettingsSchema;
 
 /* ==========================================================================
@@ -395,6 +1188,50 @@ typedef struct MenuRegistration {
     uint32_t item_count;         /* Number of items */
 } MenuRegistration;
 
+/* ==========================================================================
+ * Plugin Manifest - plugin.json next to the shared library
+ *
+ * Besides the plugin's id, name and version, the manifest may declare the
+ * plugin's node catalog so the host can build its node menu without loading
+ * the library. Keys (manifest_version 1):
+ *
+ *   "manifest_version": 1
+ *   "load":         "eager" (default) or "on_demand"
+ *   "has_settings": true if get_settings_schema returns a schema
+ *   "nodes": [
+ *     {
+ *       "unique_name": NodeDesc::unique_name
+ *       "name", "category", "description", "icon": NodeDesc strings
+ *       "color":       [r, g, b]
+ *       "flags":       NodeFlags names, lowercase without the prefix:
+ *                      "trigger_event", "pure_data", "async", "stateful",
+ *                      "hidden", "memoizable", "reports_changes",
+ *                      "signals_completion", "stateless", "thread_safe",
+ *                      "main_thread_only", "io_bound"
+ *       "pins": [
+ *         { "name":      PinDesc::name
+ *           "type":      PinDesc::type
+ *           "direction": "in" or "out"
+ *           "kind":      "data" (default) or "execution"
+ *           "flags":     "optional", "multi_connect", "hidden" }
+ *       ]
+ *     }
+ *   ]
+ *
+ * Entries follow NodeDesc and PinDesc field for field, and pins keep their
+ * array order, so PinHandle indices match the registered node.
+ *
+ * An "on_demand" plugin is loaded (NodePlugin_GetAPI, on_load, on_register)
+ * the first time a flow instantiates one of its nodes or the user opens its
+ * settings page. Until then it receives no callbacks: no on_tick, menus,
+ * Luau libraries or flow notifications, so plugins that need any of these
+ * at startup must stay "eager". After loading, the host checks that the
+ * registered nodes match the manifest and rejects the plugin if they do not.
+ *
+ * rune_manifest_dump (built with RUNE_SDK_BUILD_BENCH) prints the "nodes"
+ * array for a built plugin.
+ * ========================================================================== */
+
 /* ==========================================================================
  * Plugin Info
  * ========================================================================== */
@@ -405,7 +1242,7 @@ typedef struct PluginInfo {
     const char* version;      /* Semantic version (e.g., "1.0.0") */
     const char* author;       /* Author name/organization */
     const char* description;  /* Brief description */
-    uint32_t    api_version;  /* Must match RUNE_PLUGIN_API_VERSION */
+    uint32_t    api_version;  /* Set to RUNE_PLUGIN_API_VERSION; hosts accept any version up to their own */
 } PluginInfo;
 
 /* ==========================================================================
@@ -420,7 +1257,8 @@ typedef struct PluginAPI {
     void (*on_register)(PluginNodeRegistry* node_reg, LuauRegistry* luau_reg);
     void (*on_unload)(void);
     
-    /* Optional: Called each frame (for event polling, etc.) */
+    /* Optional: Called each frame (for event polling, etc.). In incremental
+     * mode only nodes downstream of changed outputs re-run afterwards. */
     void (*on_tick)(float delta_time);
     
     /* Optional: Called when a flow is loaded/unloaded */
@@ -433,6 +1271,13 @@ typedef struct PluginAPI {
     
     /* Optional: Menubar integration */
     const MenuRegistration* (*get_menus)(uint32_t* count);
+
+    /* ---- API version 2 ---------------------------------------------------- */
+
+    /* Optional: typed alternative to on_settings_changed for schemas that
+     * declare fields. When set, the host calls it instead of
+     * on_settings_changed; the view is valid for the duration of the call. */
+    void (*on_settings_view_changed)(const SettingsView* view);
     
 } PluginAPI;
 
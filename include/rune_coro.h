@@ -0,0 +1,595 @@
+/**
+ * RUNE Plugin SDK - Coroutine helpers for async nodes (C++20)
+ *
+ * Lets NODE_FLAG_ASYNC nodes be written as straight-line coroutines instead
+ * of hand-written state machines. The wrapper maps a coroutine onto the
+ * node's execute / is_complete entry points, host timers and host jobs.
+ * Coroutine frames are allocated from host object pools when available.
+ *
+ * Example async node:
+ *
+ *   #include <rune_coro.h>
+ *
+ *   static rune::AsyncTask fetch_body(rune::AsyncScope& scope) {
+ *       co_await scope.sleep(250);
+ *
+ *       int64_t value = 0;
+ *       if (!co_await scope.job([&] { value = compute_value(); })) {
+ *           co_return false;
+ *       }
+ *
+ *       EventValue out = {FETCH_PIN_VALUE, PIN_TYPE_INT, {0}};
+ *       out.value.i = value;
+ *       scope.post_event(FETCH_PIN_DONE, &out, 1);
+ *       co_return true;
+ *   }
+ *
+ *   static NodeVTable fetch_vtable = rune::async_node_vtable<fetch_body>();
+ *
+ * Call rune::coro_init(host) from on_load and rune::coro_shutdown() from
+ * on_unload. Register the node with NODE_FLAG_ASYNC (and, for API version 2
+ * hosts, NODE_FLAG_SIGNALS_COMPLETION).
+ *
+ * Code after a co_await runs on the thread that completed the wait (a host
+ * timer or job thread), the same as a hand-written timer callback would, so
+ * outputs should be delivered with post_event / trigger rather than through
+ * set_output_* (see the threading contract in plugin_api.h).
+ *
+ * Bodies may only co_await the scope's awaitables. Destroying an instance
+ * mid-wait cancels the wait: the pending timer is destroyed and a pending
+ * job cancelled, and the frame is freed only once their callbacks can no
+ * longer run. Cancelling a job relies on the host calling its completion
+ * callback (with success = false) for cancelled jobs too.
+ */
+
+#ifndef RUNE_PLUGIN_CORO_H
+#define RUNE_PLUGIN_CORO_H
+
+#if !defined(__cplusplus) || (__cplusplus < 202002L && (!defined(_MSVC_LANG) || _MSVC_LANG < 202002L))
+#error "rune_coro.h requires C++20"
+#endif
+
+#include "rune_plugin.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace rune {
+
+class AsyncScope;
+
+/* ==========================================================================
+ * Frame allocation - host object pools per size class
+ * ========================================================================== */
+
+namespace detail {
+
+inline HostServices* g_coro_host = nullptr;
+
+inline constexpr std::size_t kFrameClasses[] = {128, 256, 512, 1024, 2048, 4096};
+inline constexpr int kFrameClassCount = sizeof(kFrameClasses) / sizeof(kFrameClasses[0]);
+inline ObjectPool* g_frame_pools[kFrameClassCount] = {};
+
+inline std::atomic<long> g_live_frames{0};
+
+/*
+ * Every frame records where it came from, so it is returned there even if
+ * coro_init / coro_shutdown changed the pools while it was live.
+ */
+struct alignas(std::max_align_t) FrameHeader {
+    HostServices* host;  /* Null: operator new */
+    ObjectPool* pool;    /* Null: host->alloc */
+};
+
+inline int frame_class(std::size_t size) noexcept {
+    for (int i = 0; i < kFrameClassCount; ++i) {
+        if (size <= kFrameClasses[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+inline void* frame_alloc(std::size_t size) noexcept {
+    std::size_t total = size + sizeof(FrameHeader);
+    FrameHeader header = {g_coro_host, nullptr};
+    void* mem = nullptr;
+    int c = frame_class(total);
+    if (c >= 0 && g_frame_pools[c]) {
+        header.pool = g_frame_pools[c];
+        mem = g_coro_host->pool_alloc(header.pool);
+    } else if (g_coro_host && g_coro_host->alloc) {
+        mem = g_coro_host->alloc(total);
+    } else {
+        header.host = nullptr;
+        mem = ::operator new(total, std::nothrow);
+    }
+    if (!mem) {
+        return nullptr;
+    }
+    g_live_frames.fetch_add(1, std::memory_order_relaxed);
+    return new (mem) FrameHeader(header) + 1;
+}
+
+inline void frame_free(void* ptr, std::size_t /*size*/) noexcept {
+    if (!ptr) {
+        return;
+    }
+    FrameHeader* header = static_cast<FrameHeader*>(ptr) - 1;
+    FrameHeader from = *header;
+    if (from.pool) {
+        from.host->pool_free(from.pool, header);
+    } else if (from.host) {
+        from.host->free(header);
+    } else {
+        ::operator delete(header);
+    }
+    g_live_frames.fetch_sub(1, std::memory_order_release);
+}
+
+/*
+ * Hand-off for the wait a body is blocked on, between the thread that
+ * suspends, the thread that completes the wait and the flow thread that may
+ * destroy the instance meanwhile:
+ *   ARMING     the body is running (arming a wait, or between waits)
+ *   SUSPENDED  the body is suspended and its wait has not completed
+ *   COMPLETED  the wait's callback has run
+ *   CANCELLED  the scope is stopping the body; the callback must not resume it
+ * Completion may race with arming, so whichever side comes second decides:
+ * if the wait already completed, suspend() fails and the body continues
+ * inline; otherwise complete() resumes it. Cancellation only wins from
+ * SUSPENDED, and cancel / cancel_arg are written while ARMING and read only
+ * after that CAS, so the gate orders them.
+ */
+struct ResumeGate {
+    enum { ARMING = 0, SUSPENDED = 1, COMPLETED = 2, CANCELLED = 3 };
+
+    std::atomic<int> state{COMPLETED};
+    void (*cancel)(void*) = nullptr;  /* Stops the callback of the armed wait */
+    void* cancel_arg = nullptr;
+
+    /* Register the wait's cancel hook; call before arming its timer or job */
+    void arm(void (*fn)(void*), void* arg) noexcept {
+        state.store(ARMING, std::memory_order_relaxed);
+        cancel = fn;
+        cancel_arg = arg;
+    }
+
+    /* Returns false if the wait completed while arming */
+    bool suspend() noexcept {
+        int expected = ARMING;
+        return state.compare_exchange_strong(expected, SUSPENDED, std::memory_order_acq_rel);
+    }
+
+    /* Callback side. After the exchange a cancelled wait's memory may be
+     * freed at any moment, so nothing is touched past it. */
+    void complete(std::coroutine_handle<> handle) noexcept {
+        if (state.exchange(COMPLETED, std::memory_order_acq_rel) == SUSPENDED) {
+            handle.resume();
+        }
+    }
+
+    /* Flow-thread side. Returns true if the body was stopped while
+     * suspended (its hook has then run); false while the body is running. */
+    bool try_cancel() noexcept {
+        int expected = SUSPENDED;
+        if (!state.compare_exchange_strong(expected, CANCELLED, std::memory_order_acq_rel)) {
+            return false;
+        }
+        cancel(cancel_arg);
+        return true;
+    }
+
+    /* For cancel hooks that cannot stop a callback already under way */
+    void wait_completed() const noexcept {
+        while (state.load(std::memory_order_acquire) != COMPLETED) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * coro_init - Set up frame pools; call from on_load
+ *
+ * Pools left over from a coro_shutdown that refused to run are kept.
+ */
+inline void coro_init(HostServices* host) {
+    if (detail::g_coro_host && detail::g_coro_host != host) {
+        return;  /* Frames of the previous host are still live */
+    }
+    detail::g_coro_host = host;
+    if (RUNE_HOST_API_AT_LEAST(host, 2) && host->pool_create) {
+        for (int i = 0; i < detail::kFrameClassCount; ++i) {
+            if (!detail::g_frame_pools[i]) {
+                detail::g_frame_pools[i] = host->pool_create((uint32_t)detail::kFrameClasses[i],
+                                                             (uint32_t)alignof(std::max_align_t));
+            }
+        }
+    }
+}
+
+/**
+ * coro_shutdown - Release frame pools; call from on_unload after all async
+ * node instances have been destroyed
+ *
+ * Returns false, and releases nothing, while coroutine frames or async node
+ * instances are still live, since their memory belongs to the pools.
+ */
+inline bool coro_shutdown() {
+    HostServices* host = detail::g_coro_host;
+    if (!host) {
+        return true;
+    }
+    long live = detail::g_live_frames.load(std::memory_order_acquire);
+    if (live != 0) {
+        RUNE_LOG_WARN(host, "rune_coro: %ld coroutine frames still live, keeping frame pools", live);
+        return false;
+    }
+    for (int i = 0; i < detail::kFrameClassCount; ++i) {
+        if (detail::g_frame_pools[i]) {
+            host->pool_destroy(detail::g_frame_pools[i]);
+            detail::g_frame_pools[i] = nullptr;
+        }
+    }
+    detail::g_coro_host = nullptr;
+    return true;
+}
+
+/* ==========================================================================
+ * AsyncTask - Coroutine return type for async node bodies
+ * ========================================================================== */
+
+class AsyncTask {
+public:
+    struct promise_type {
+        AsyncScope* scope;
+        bool success = false;
+
+        explicit promise_type(AsyncScope& s) noexcept : scope(&s) {}
+
+        /* Frames come from the host pools; the size passed to delete always
+         * matches the size passed to new for coroutine frames. */
+        static void* operator new(std::size_t size, AsyncScope&) noexcept {
+            return detail::frame_alloc(size);
+        }
+        static void operator delete(void* ptr, std::size_t size) noexcept {
+            detail::frame_free(ptr, size);
+        }
+        static AsyncTask get_return_object_on_allocation_failure() noexcept {
+            return AsyncTask(nullptr);
+        }
+
+        AsyncTask get_return_object() noexcept {
+            return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        /* Started explicitly by AsyncScope once the handle is stored */
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> h) noexcept;
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(bool ok) noexcept { success = ok; }
+
+        /* Exceptions escaping the body fail the node rather than crossing
+         * into a host timer or job thread */
+        void unhandled_exception() noexcept { success = false; }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    AsyncTask(AsyncTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    AsyncTask(const AsyncTask&) = delete;
+    AsyncTask& operator=(const AsyncTask&) = delete;
+    ~AsyncTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    explicit operator bool() const noexcept { return (bool)handle_; }
+    Handle release() noexcept { return std::exchange(handle_, nullptr); }
+
+private:
+    explicit AsyncTask(Handle h) noexcept : handle_(h) {}
+
+    Handle handle_;
+};
+
+/* ==========================================================================
+ * AsyncScope - Per-instance state and awaitables for async node bodies
+ * ========================================================================== */
+
+class AsyncScope {
+public:
+    ExecContext* ctx() const noexcept { return ctx_; }
+    HostServices* host() const noexcept { return detail::g_coro_host; }
+
+    /* Fire an execution output. Goes through the thread-safe event queue on
+     * API version 2 hosts, so it may be called after any co_await. */
+    void trigger(const char* exec_pin_name) {
+        if (RUNE_HOST_API_AT_LEAST(host(), 2)) {
+            post_event(ctx_->resolve_pin(ctx_, exec_pin_name), nullptr, 0);
+        } else {
+            ctx_->trigger_output(ctx_, exec_pin_name);
+        }
+    }
+    void trigger(PinHandle exec_pin) {
+        if (RUNE_HOST_API_AT_LEAST(host(), 2)) {
+            post_event(exec_pin, nullptr, 0);
+        } else {
+            ctx_->trigger_output_h(ctx_, exec_pin);
+        }
+    }
+
+    /* Set data outputs and fire an execution output from any thread
+     * (API version 2) */
+    bool post_event(PinHandle exec_pin, const EventValue* values, uint32_t count) {
+        return ctx_->post_event(ctx_, exec_pin, values, count);
+    }
+
+    /* co_await scope.sleep(ms) -> true, or false if the wait could not be
+     * armed. Uses create_timer_ex; hosts without it only have timers that
+     * cannot be cancelled safely, so there the wait runs on a job worker. */
+    class SleepAwaiter {
+    public:
+        SleepAwaiter(AsyncScope* scope, uint32_t ms) noexcept : scope_(scope), ms_(ms) {}
+
+        bool await_ready() const noexcept { return ms_ == 0; }
+
+        bool await_suspend(std::coroutine_handle<> h) noexcept {
+            HostServices* host = scope_->host();
+            detail::ResumeGate& gate = scope_->gate_;
+            handle_ = h;
+            if (RUNE_HOST_API_AT_LEAST(host, 2) && host->create_timer_ex) {
+                gate.arm(&SleepAwaiter::cancel_timer, this);
+                TimerDesc desc = {(uint64_t)ms_ * 1000u, 0, TIMER_MODE_ONE_SHOT, &SleepAwaiter::on_timer, this};
+                timer_id_ = host->create_timer_ex(&desc);
+                armed_ = timer_id_ != 0;
+            } else if (host && host->submit_job) {
+                gate.arm(&SleepAwaiter::cancel_job, this);
+                armed_ = true;
+                job_ = host->submit_job(&SleepAwaiter::run_sleep, this, &SleepAwaiter::on_job_complete);
+            }
+            return armed_ && gate.suspend();
+        }
+
+        bool await_resume() const noexcept { return ms_ == 0 || armed_; }
+
+    private:
+        static void on_timer(void* user_data) {
+            SleepAwaiter* self = static_cast<SleepAwaiter*>(user_data);
+            self->scope_->gate_.complete(self->handle_);
+        }
+
+        /* destroy_timer returns once the callback is neither running nor
+         * will run */
+        static void cancel_timer(void* user_data) {
+            SleepAwaiter* self = static_cast<SleepAwaiter*>(user_data);
+            self->scope_->host()->destroy_timer(self->timer_id_);
+        }
+
+        /* Sleeps in short slices so a cancelled wait frees its worker soon */
+        static void run_sleep(void* user_data) {
+            SleepAwaiter* self = static_cast<SleepAwaiter*>(user_data);
+            const detail::ResumeGate& gate = self->scope_->gate_;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(self->ms_);
+            while (gate.state.load(std::memory_order_acquire) != detail::ResumeGate::CANCELLED) {
+                auto left = deadline - std::chrono::steady_clock::now();
+                if (left <= std::chrono::steady_clock::duration::zero()) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(left, std::chrono::milliseconds(10)));
+            }
+        }
+
+        static void on_job_complete(void* user_data, bool success) {
+            SleepAwaiter* self = static_cast<SleepAwaiter*>(user_data);
+            (void)success;
+            self->scope_->gate_.complete(self->handle_);
+        }
+
+        static void cancel_job(void* user_data) {
+            SleepAwaiter* self = static_cast<SleepAwaiter*>(user_data);
+            const detail::ResumeGate& gate = self->scope_->gate_;
+            self->scope_->host()->cancel_job(self->job_);
+            gate.wait_completed();
+        }
+
+        AsyncScope* scope_;
+        uint32_t ms_;
+        bool armed_ = false;
+        uint64_t timer_id_ = 0;
+        JobHandle job_ = {0};
+        std::coroutine_handle<> handle_;
+    };
+
+    SleepAwaiter sleep(uint32_t ms) noexcept { return SleepAwaiter(this, ms); }
+
+    /* co_await scope.job(fn) -> true once fn() has run on the job system,
+     * false if it threw, was cancelled or could not be submitted */
+    template <typename Fn>
+    class JobAwaiter {
+    public:
+        JobAwaiter(AsyncScope* scope, Fn fn) : scope_(scope), fn_(std::move(fn)) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h) noexcept {
+            HostServices* host = scope_->host();
+            if (!host || !host->submit_job) {
+                return false;
+            }
+            handle_ = h;
+            submitted_ = true;
+            scope_->gate_.arm(&JobAwaiter::cancel, this);
+            job_ = host->submit_job(&JobAwaiter::run, this, &JobAwaiter::on_complete);
+            return scope_->gate_.suspend();
+        }
+
+        bool await_resume() const noexcept { return submitted_ && ok_; }
+
+    private:
+        static void run(void* user_data) {
+            JobAwaiter* self = static_cast<JobAwaiter*>(user_data);
+            try {
+                self->fn_();
+                self->ok_ = true;
+            } catch (...) {
+                self->ok_ = false;
+            }
+        }
+
+        static void on_complete(void* user_data, bool success) {
+            JobAwaiter* self = static_cast<JobAwaiter*>(user_data);
+            self->ok_ = self->ok_ && success;
+            self->scope_->gate_.complete(self->handle_);
+        }
+
+        /* A job that already started cannot be stopped, so this waits for
+         * its completion callback before the frame goes away */
+        static void cancel(void* user_data) {
+            JobAwaiter* self = static_cast<JobAwaiter*>(user_data);
+            HostServices* host = self->scope_->host();
+            const detail::ResumeGate& gate = self->scope_->gate_;
+            host->cancel_job(self->job_);
+            if (RUNE_HOST_API_AT_LEAST(host, 2) && host->wait_job) {
+                host->wait_job(self->job_, RUNE_WAIT_INFINITE);
+            }
+            gate.wait_completed();
+        }
+
+        AsyncScope* scope_;
+        Fn fn_;
+        JobHandle job_ = {0};
+        bool submitted_ = false;
+        bool ok_ = false;
+        std::coroutine_handle<> handle_;
+    };
+
+    template <typename Fn>
+    JobAwaiter<Fn> job(Fn fn) { return JobAwaiter<Fn>(this, std::move(fn)); }
+
+private:
+    template <AsyncTask (*Body)(AsyncScope&)>
+    friend struct AsyncNode;
+    friend struct AsyncTask::promise_type::FinalAwaiter;
+
+    /* Called at final suspend, possibly on a timer or job thread. The frame
+     * and the scope may be destroyed as soon as settled_ is published. */
+    void finish(bool success) noexcept {
+        success_ = success;
+        done_.store(true, std::memory_order_release);
+        if (RUNE_HOST_API_AT_LEAST(host(), 2) && ctx_->signal_complete) {
+            ctx_->signal_complete(ctx_, success);
+        }
+        settled_.store(true, std::memory_order_release);
+    }
+
+    /* Stops the body and frees its frame. A suspended body is cancelled
+     * through the gate; a body that a timer or job thread is running right
+     * now is left to reach its next suspension (or the end) first. */
+    void reset() noexcept {
+        if (!handle_) {
+            return;
+        }
+        while (!settled_.load(std::memory_order_acquire) && !gate_.try_cancel()) {
+            std::this_thread::yield();
+        }
+        handle_.destroy();
+        handle_ = nullptr;
+    }
+
+    ExecContext* ctx_ = nullptr;
+    AsyncTask::Handle handle_;
+    std::atomic<bool> done_{true};     /* Body reached final suspend */
+    std::atomic<bool> settled_{true};  /* ... and finish() no longer touches the scope */
+    bool success_ = false;
+    detail::ResumeGate gate_;
+};
+
+inline void AsyncTask::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> h) noexcept {
+    promise_type& promise = h.promise();
+    promise.scope->finish(promise.success);
+}
+
+/* ==========================================================================
+ * AsyncNode - NodeVTable entry points driving a coroutine body
+ * ========================================================================== */
+
+template <AsyncTask (*Body)(AsyncScope&)>
+struct AsyncNode {
+    static void* create_instance(void) {
+        void* mem = detail::frame_alloc(sizeof(AsyncScope));
+        return mem ? new (mem) AsyncScope() : nullptr;
+    }
+
+    static void destroy_instance(void* inst) {
+        AsyncScope* scope = static_cast<AsyncScope*>(inst);
+        if (scope) {
+            scope->reset();
+            scope->~AsyncScope();
+            detail::frame_free(scope, sizeof(AsyncScope));
+        }
+    }
+
+    static bool execute(void* inst, ExecContext* ctx) {
+        AsyncScope* scope = static_cast<AsyncScope*>(inst);
+        if (!scope) {
+            return false;
+        }
+        if (!scope->done_.load(std::memory_order_acquire)) {
+            ctx->set_error(ctx, "Async node is already running");
+            return false;
+        }
+        scope->reset();
+
+        scope->ctx_ = ctx;
+        AsyncTask task = Body(*scope);
+        if (!task) {
+            ctx->set_error(ctx, "Failed to allocate coroutine frame");
+            return false;
+        }
+
+        scope->done_.store(false, std::memory_order_release);
+        scope->settled_.store(false, std::memory_order_relaxed);
+        scope->handle_ = task.release();
+        scope->handle_.resume();
+        return true;
+    }
+
+    static bool is_complete(void* inst) {
+        AsyncScope* scope = static_cast<AsyncScope*>(inst);
+        return scope ? scope->done_.load(std::memory_order_acquire) : true;
+    }
+};
+
+/**
+ * async_node_vtable - Build a NodeVTable for a coroutine node body
+ */
+template <AsyncTask (*Body)(AsyncScope&)>
+NodeVTable async_node_vtable() {
+    NodeVTable vtbl = {};
+    vtbl.create_instance = &AsyncNode<Body>::create_instance;
+    vtbl.destroy_instance = &AsyncNode<Body>::destroy_instance;
+    vtbl.execute = &AsyncNode<Body>::execute;
+    vtbl.is_complete = &AsyncNode<Body>::is_complete;
+    return vtbl;
+}
+
+} // namespace rune
+
+#endif /* RUNE_PLUGIN_CORO_H */
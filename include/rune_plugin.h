@@ -40,6 +40,9 @@
 /* Include the main plugin API */
 #include "plugin_api.h"
 
+#include <math.h>
+#include <string.h>
+
 /* Helper macros for plugin development */
 
 /**
@@ -89,6 +92,8 @@
         flags, \
         NULL, \
         NULL, \
+        NULL, \
+        NULL, \
         NULL \
     }
 
@@ -116,6 +121,44 @@
 #define RUNE_EXEC_PIN_OUT(name) \
     {name, "execution", PIN_OUT, PIN_KIND_EXECUTION, 0}
 
+/**
+ * RUNE_HOST_API_AT_LEAST - Check whether the host implements an API version
+ *
+ * Members added in later API versions must only be used when this is true.
+ * The result is stable for the lifetime of the plugin, so cache it in on_load.
+ */
+#define RUNE_HOST_API_AT_LEAST(host, version) \
+    ((host) != NULL && (host)->api_version >= (version))
+
+/* ==========================================================================
+ * Pin Handles (API version 2)
+ *
+ * A PinHandle is the index of the pin in the node's PinDesc array. Declaring
+ * the indices as constants next to the pin array avoids a name lookup on
+ * every call:
+ *
+ *   enum { MY_PIN_IN = 0, MY_PIN_OUT = 1 };
+ *
+ *   static PinDesc my_node_pins[] = {
+ *       RUNE_DATA_PIN_IN("Input", "float"),
+ *       RUNE_DATA_PIN_OUT("Output", "float"),
+ *   };
+ *
+ *   double v = ctx->get_input_float_h(ctx, MY_PIN_IN);
+ *   ctx->set_output_float_h(ctx, MY_PIN_OUT, v * 2.0);
+ *
+ * Handles for pins known only at runtime come from ctx->resolve_pin().
+ * ========================================================================== */
+
+/**
+ * RUNE_BATCH_COLUMN - Get a typed column from a BatchContext
+ *
+ * Usage:
+ *   const double* a = RUNE_BATCH_COLUMN(batch, MY_PIN_IN, const double);
+ *   double* out = RUNE_BATCH_COLUMN(batch, MY_PIN_OUT, double);
+ */
+#define RUNE_BATCH_COLUMN(batch, pin, type) ((type*)(batch)->columns[(pin)])
+
 /**
  * RUNE_DEFINE_SETTINGS_SCHEMA - Define a plugin settings schema
  *
@@ -135,6 +178,22 @@
     static PluginSettingsSchema g_SettingsSchema = { schema, defaults }; \
     static const PluginSettingsSchema* GetSettingsSchema(void) { return &g_SettingsSchema; }
 
+/**
+ * RUNE_DEFINE_TYPED_SETTINGS_SCHEMA - Settings schema with typed fields (API version 2)
+ *
+ * Usage:
+ *   enum { MY_SETTING_ENABLED = 0 };
+ *   static const SettingsField my_fields[] = { {"enabled", SETTINGS_FIELD_BOOL} };
+ *   RUNE_DEFINE_TYPED_SETTINGS_SCHEMA(schema, defaults, my_fields, 1)
+ *
+ *   static void on_settings_view_changed(const SettingsView* view) {
+ *       bool enabled = host->settings_get_bool(view, MY_SETTING_ENABLED);
+ *   }
+ */
+#define RUNE_DEFINE_TYPED_SETTINGS_SCHEMA(schema, defaults, fields, field_count) \
+    static PluginSettingsSchema g_SettingsSchema = { schema, defaults, fields, field_count }; \
+    static const PluginSettingsSchema* GetSettingsSchema(void) { return &g_SettingsSchema; }
+
 /**
  * RUNE_MENU_ITEM - Define a menu item with callback
  */
@@ -159,6 +218,398 @@
 #define RUNE_DEFINE_MENU(menu_id, items_array, count) \
     { menu_id, items_array, count }
 
+/* ==========================================================================
+ * Node IR (API version 2)
+ *
+ * Usage (Result = A * B + 1):
+ *   static const double my_constants[] = {1.0};
+ *   static const NodeIrInstr my_code[] = {
+ *       RUNE_IR_INPUT(0, MY_PIN_A),
+ *       RUNE_IR_INPUT(1, MY_PIN_B),
+ *       RUNE_IR_OP(NODE_IR_OP_MUL, 2, 0, 1),
+ *       RUNE_IR_CONST(3, 0),
+ *       RUNE_IR_OP(NODE_IR_OP_ADD, 2, 2, 3),
+ *       RUNE_IR_OUTPUT(MY_PIN_RESULT, 2),
+ *   };
+ *   static const NodeIr my_ir = RUNE_DEFINE_NODE_IR_CONST(my_code, 4, my_constants);
+ * and set NodeDesc::ir = &my_ir.
+ * ========================================================================== */
+
+#define RUNE_IR_INPUT(dst, pin)     { NODE_IR_OP_INPUT, (dst), 0, 0, (pin) }
+#define RUNE_IR_CONST(dst, index)   { NODE_IR_OP_CONST, (dst), 0, 0, (index) }
+#define RUNE_IR_OP(op, dst, a, b)   { (op), (dst), (a), (b), 0 }
+#define RUNE_IR_GUARD_NONZERO(reg)  { NODE_IR_OP_GUARD_NONZERO, 0, (reg), 0, 0 }
+#define RUNE_IR_OUTPUT(pin, src)    { NODE_IR_OP_OUTPUT, 0, (src), 0, (pin) }
+
+/* code and constants must be arrays, not pointers */
+#define RUNE_DEFINE_NODE_IR(code, register_count) \
+    { NODE_IR_VERSION, (register_count), (code), (uint32_t)(sizeof(code) / sizeof((code)[0])), NULL, 0 }
+
+#define RUNE_DEFINE_NODE_IR_CONST(code, register_count, constants) \
+    { NODE_IR_VERSION, (register_count), (code), (uint32_t)(sizeof(code) / sizeof((code)[0])), \
+      (constants), (uint32_t)(sizeof(constants) / sizeof((constants)[0])) }
+
+/**
+ * rune_ir_eval - Reference interpreter for a node's IR
+ *
+ * inputs and outputs are indexed by PinHandle and hold pin_count values.
+ * Returns false if a guard fails or the IR is malformed; hosts then fall back
+ * to execute. Intended for checking that the IR matches execute.
+ */
+static inline bool rune_ir_eval(const NodeIr* ir, const double* inputs, double* outputs, uint32_t pin_count) {
+    double r[NODE_IR_MAX_REGISTERS];
+    uint32_t i;
+    if (!ir || ir->version != NODE_IR_VERSION || ir->register_count > NODE_IR_MAX_REGISTERS) {
+        return false;
+    }
+    for (i = 0; i < ir->code_count; ++i) {
+        const NodeIrInstr* in = &ir->code[i];
+        if (in->dst >= ir->register_count || in->a >= ir->register_count || in->b >= ir->register_count) {
+            return false;
+        }
+        switch (in->op) {
+            case NODE_IR_OP_INPUT:
+                if (in->arg >= pin_count) return false;
+                r[in->dst] = inputs[in->arg];
+                break;
+            case NODE_IR_OP_CONST:
+                if (in->arg >= ir->constant_count) return false;
+                r[in->dst] = ir->constants[in->arg];
+                break;
+            case NODE_IR_OP_OUTPUT:
+                if (in->arg >= pin_count) return false;
+                outputs[in->arg] = r[in->a];
+                break;
+            case NODE_IR_OP_GUARD_NONZERO:
+                if (r[in->a] == 0.0) return false;
+                break;
+            case NODE_IR_OP_ADD:  r[in->dst] = r[in->a] + r[in->b]; break;
+            case NODE_IR_OP_SUB:  r[in->dst] = r[in->a] - r[in->b]; break;
+            case NODE_IR_OP_MUL:  r[in->dst] = r[in->a] * r[in->b]; break;
+            case NODE_IR_OP_DIV:  r[in->dst] = r[in->a] / r[in->b]; break;
+            case NODE_IR_OP_POW:  r[in->dst] = pow(r[in->a], r[in->b]); break;
+            case NODE_IR_OP_MIN:  r[in->dst] = r[in->a] < r[in->b] ? r[in->a] : r[in->b]; break;
+            case NODE_IR_OP_MAX:  r[in->dst] = r[in->a] > r[in->b] ? r[in->a] : r[in->b]; break;
+            case NODE_IR_OP_NEG:  r[in->dst] = -r[in->a]; break;
+            case NODE_IR_OP_ABS:  r[in->dst] = fabs(r[in->a]); break;
+            case NODE_IR_OP_SQRT: r[in->dst] = sqrt(r[in->a]); break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/* ==========================================================================
+ * Hot Reload (API version 2)
+ *
+ * Registering through rune_register_or_replace makes a plugin reloadable:
+ * when a previous build already registered the type, its vtable is swapped
+ * and live instances are migrated through serialize_to / deserialize_from
+ * (see PluginNodeRegistry in plugin_api.h). Instances restored that way
+ * should keep their state across the start_listening that follows.
+ * ========================================================================== */
+
+/**
+ * rune_register_or_replace - register_node, or replace_node for a type that
+ * is already registered. Returns the type ID, or 0 on failure.
+ */
+static inline NodeTypeId rune_register_or_replace(HostServices* host, PluginNodeRegistry* reg,
+                                                  const NodeDesc* desc, const NodeVTable* vtbl) {
+    if (RUNE_HOST_API_AT_LEAST(host, 2) && reg->find_node && reg->replace_node) {
+        NodeTypeId existing = reg->find_node(desc->unique_name);
+        if (existing) {
+            return reg->replace_node(existing, desc, vtbl) ? existing : 0;
+        }
+    }
+    return reg->register_node(desc, vtbl);
+}
+
+/* ==========================================================================
+ * Luau Fast Calls (API version 2)
+ *
+ *   static double my_lerp(double a, double b, double t) { return a + (b - a) * t; }
+ *
+ *   rune_luau_fastcall(host, luau, L, "mylib", "lerp", "ddd->d", RUNE_FASTCALL_FN(my_lerp));
+ * ========================================================================== */
+
+#define RUNE_FASTCALL_FN(fn) ((LuaFastcallFunction)(fn))
+
+/**
+ * rune_luau_fastcall - register_fastcall if the host has it. Returns false
+ * when it does not or the signature is rejected.
+ */
+static inline bool rune_luau_fastcall(HostServices* host, LuauRegistry* luau, void* L, const char* lib_name,
+                                      const char* name, const char* signature, LuaFastcallFunction fn) {
+    return RUNE_HOST_API_AT_LEAST(host, 2) && luau && luau->register_fastcall &&
+           luau->register_fastcall(L, lib_name, name, signature, fn);
+}
+
+/* ==========================================================================
+ * CPU Feature Dispatch
+ *
+ * Build kernels once per ISA with rune_add_plugin_isa_variants (CMake), then
+ * pick the best one in on_load:
+ *
+ *   static const RuneKernel my_variants[] = {
+ *   #ifdef RUNE_ISA_HAS_AVX512
+ *       {RUNE_CPU_AVX512, &my_kernels_avx512},
+ *   #endif
+ *   #ifdef RUNE_ISA_HAS_AVX2
+ *       {RUNE_CPU_AVX2 | RUNE_CPU_FMA, &my_kernels_avx2},
+ *   #endif
+ *       {0, &my_kernels_baseline},
+ *   };
+ *
+ *   g_kernels = (const MyKernels*)rune_select_kernel(rune_cpu_features(host), my_variants,
+ *                                                    sizeof(my_variants) / sizeof(my_variants[0]));
+ *
+ * Inside a variant's sources RUNE_ISA_SYMBOL(my_kernels) names the
+ * variant's copy (my_kernels_avx2, my_kernels_baseline, ...).
+ * ========================================================================== */
+
+#define RUNE_ISA_CONCAT_(a, b) a##b
+#define RUNE_ISA_CONCAT(a, b)  RUNE_ISA_CONCAT_(a, b)
+#ifdef RUNE_ISA_SUFFIX
+#define RUNE_ISA_SYMBOL(name)  RUNE_ISA_CONCAT(name, RUNE_ISA_SUFFIX)
+#else
+#define RUNE_ISA_SYMBOL(name)  RUNE_ISA_CONCAT(name, _baseline)
+#endif
+
+typedef struct RuneKernel {
+    uint64_t    required;  /* RUNE_CPU_* bits the variant was compiled for */
+    const void* kernel;    /* Typically a table of function pointers */
+} RuneKernel;
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+/**
+ * rune_detect_cpu_features - Probe RUNE_CPU_* bits directly. Prefer
+ * rune_cpu_features, which uses the host's cached value when it has one.
+ */
+static inline uint64_t rune_detect_cpu_features(void) {
+    uint64_t features = 0;
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    /* Both builtins check OS support for the wider register state too */
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2"))   features |= RUNE_CPU_SSE4_2;
+    if (__builtin_cpu_supports("avx"))      features |= RUNE_CPU_AVX;
+    if (__builtin_cpu_supports("avx2"))     features |= RUNE_CPU_AVX2;
+    if (__builtin_cpu_supports("fma"))      features |= RUNE_CPU_FMA;
+    if (__builtin_cpu_supports("avx512f"))  features |= RUNE_CPU_AVX512F;
+    if (__builtin_cpu_supports("avx512bw")) features |= RUNE_CPU_AVX512BW;
+    if (__builtin_cpu_supports("avx512dq")) features |= RUNE_CPU_AVX512DQ;
+    if (__builtin_cpu_supports("avx512vl")) features |= RUNE_CPU_AVX512VL;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int r[4];
+    unsigned long long xcr0 = 0;
+    __cpuid(r, 1);
+    if (r[2] & (1 << 20)) features |= RUNE_CPU_SSE4_2;
+    if (r[2] & (1 << 27)) xcr0 = _xgetbv(0);  /* OSXSAVE */
+    if ((xcr0 & 0x06) == 0x06) {               /* XMM and YMM state */
+        if (r[2] & (1 << 28)) features |= RUNE_CPU_AVX;
+        if (r[2] & (1 << 12)) features |= RUNE_CPU_FMA;
+        __cpuidex(r, 7, 0);
+        if (r[1] & (1 << 5)) features |= RUNE_CPU_AVX2;
+        if ((xcr0 & 0xE6) == 0xE6) {           /* Plus opmask and ZMM state */
+            if (r[1] & (1 << 16)) features |= RUNE_CPU_AVX512F;
+            if (r[1] & (1 << 17)) features |= RUNE_CPU_AVX512DQ;
+            if (r[1] & (1 << 30)) features |= RUNE_CPU_AVX512BW;
+            if (r[1] & (1u << 31)) features |= RUNE_CPU_AVX512VL;
+        }
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    features |= RUNE_CPU_NEON;  /* Mandatory on AArch64 */
+#endif
+    return features;
+}
+
+/**
+ * rune_cpu_features - The host's get_cpu_features, or a direct probe on
+ * hosts without it. Call once (e.g. in on_load) and keep the result.
+ */
+static inline uint64_t rune_cpu_features(HostServices* host) {
+    if (RUNE_HOST_API_AT_LEAST(host, 2) && host->get_cpu_features) {
+        return host->get_cpu_features();
+    }
+    return rune_detect_cpu_features();
+}
+
+/**
+ * rune_select_kernel - First variant whose required bits are all in
+ * features. List variants best first and end with a baseline ({0, ...});
+ * returns NULL only if no entry matches.
+ */
+static inline const void* rune_select_kernel(uint64_t features, const RuneKernel* variants, uint32_t count) {
+    uint32_t i;
+    for (i = 0; i < count; ++i) {
+        if ((variants[i].required & features) == variants[i].required) {
+            return variants[i].kernel;
+        }
+    }
+    return NULL;
+}
+
+/* ==========================================================================
+ * Profiling (API version 2)
+ *
+ * Sub-spans show up nested under the node's execute span in exported traces:
+ *
+ *   uint64_t scope = RUNE_PROFILE_BEGIN(host, "myplugin.decode");
+ *   decode(...);
+ *   RUNE_PROFILE_END(host, scope);
+ * ========================================================================== */
+
+#define RUNE_PROFILE_BEGIN(host, name) \
+    ((RUNE_HOST_API_AT_LEAST(host, 2) && (host)->profile_scope_begin) \
+        ? (host)->profile_scope_begin(name) : (uint64_t)0)
+
+#define RUNE_PROFILE_END(host, scope) \
+    do { \
+        if ((scope) != 0) { \
+            (host)->profile_scope_end(scope); \
+        } \
+    } while (0)
+
+/* ==========================================================================
+ * Level-Gated Logging
+ *
+ * RUNE_LOG_DEBUG / INFO / WARN / ERROR check the host's log level before
+ * formatting, so dropped messages cost a single call (hosts older than API
+ * version 2 cannot be queried and always format):
+ *
+ *   RUNE_LOG_DEBUG(host, "Delay started: %lld ms", (long long)delay_ms);
+ *
+ * Levels below RUNE_MIN_LOG_LEVEL compile to nothing, e.g. build release
+ * plugins with -DRUNE_MIN_LOG_LEVEL=1 to strip DEBUG messages. The value must
+ * be a plain number for the preprocessor: 0 = DEBUG, 1 = INFO, 2 = WARN,
+ * 3 = ERROR.
+ * ========================================================================== */
+
+#ifndef RUNE_MIN_LOG_LEVEL
+#define RUNE_MIN_LOG_LEVEL 0
+#endif
+
+/**
+ * rune_log_enabled - Whether the host records messages at a level
+ */
+static inline bool rune_log_enabled(HostServices* host, PluginLogLevel level) {
+    if (RUNE_HOST_API_AT_LEAST(host, 2) && host->is_log_enabled) {
+        return host->is_log_enabled(level);
+    }
+    return host != NULL;
+}
+
+#define RUNE_LOG_AT(host, level, ...) \
+    do { \
+        if (rune_log_enabled((host), (level))) { \
+            (host)->log_formatted((level), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#if RUNE_MIN_LOG_LEVEL <= 0
+#define RUNE_LOG_DEBUG(host, ...) RUNE_LOG_AT(host, PLUGIN_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define RUNE_LOG_DEBUG(host, ...) ((void)0)
+#endif
+
+#if RUNE_MIN_LOG_LEVEL <= 1
+#define RUNE_LOG_INFO(host, ...) RUNE_LOG_AT(host, PLUGIN_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define RUNE_LOG_INFO(host, ...) ((void)0)
+#endif
+
+#if RUNE_MIN_LOG_LEVEL <= 2
+#define RUNE_LOG_WARN(host, ...) RUNE_LOG_AT(host, PLUGIN_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define RUNE_LOG_WARN(host, ...) ((void)0)
+#endif
+
+#define RUNE_LOG_ERROR(host, ...) RUNE_LOG_AT(host, PLUGIN_LOG_LEVEL_ERROR, __VA_ARGS__)
+
+/**
+ * RUNE_LOG_FORMAT_REGISTER - Register a deferred log format (0 if unsupported)
+ *
+ * Usage:
+ *   // on_load
+ *   g_fmt_started = RUNE_LOG_FORMAT_REGISTER(host, LOG_LEVEL_DEBUG, "Started: %lld ms");
+ *   // hot path
+ *   if (g_fmt_started) host->log_deferred(g_fmt_started, (long long)ms);
+ */
+#define RUNE_LOG_FORMAT_REGISTER(host, level, format) \
+    ((RUNE_HOST_API_AT_LEAST(host, 2) && (host)->log_register_format && (host)->log_deferred) \
+        ? (host)->log_register_format((level), (format)) : (uint32_t)0)
+
+/* ==========================================================================
+ * String Views (API version 2)
+ *
+ * Pass strings by pointer and length instead of strlen + copy:
+ *   StringView name;
+ *   if (ctx->get_input_string_view(ctx, MY_PIN_NAME, &name) &&
+ *       rune_sv_equals(name, rune_sv("debug"))) { ... }
+ *   ctx->set_output_string_borrowed(ctx, MY_PIN_MODE, rune_sv("fast"));
+ *
+ * Strings from a small, repeating set can be interned once and then output
+ * without copies, since interned strings outlive every flow run:
+ *   StringId id = rune_intern(host, value);
+ *   if (id) ctx->set_output_string_borrowed(ctx, pin, host->intern_lookup(id));
+ * ========================================================================== */
+
+/**
+ * rune_sv - View of a NUL-terminated string (NULL gives an empty view)
+ */
+static inline StringView rune_sv(const char* str) {
+    StringView view;
+    view.ptr = str ? str : "";
+    view.len = str ? strlen(str) : 0;
+    return view;
+}
+
+static inline bool rune_sv_equals(StringView a, StringView b) {
+    return a.len == b.len && (a.len == 0 || memcmp(a.ptr, b.ptr, a.len) == 0);
+}
+
+/**
+ * rune_intern - Intern a NUL-terminated string; STRING_ID_INVALID if the
+ * host has no interner
+ */
+static inline StringId rune_intern(HostServices* host, const char* str) {
+    if (!str || !RUNE_HOST_API_AT_LEAST(host, 2) || !host->intern || !host->intern_lookup) {
+        return STRING_ID_INVALID;
+    }
+    return host->intern(str, strlen(str));
+}
+
+/* ==========================================================================
+ * CSV Reader Helpers
+ * ========================================================================== */
+
+/**
+ * rune_csv_unescape - Copy a CSV cell into a buffer, collapsing "" to "
+ *
+ * Only needed when CsvBatch::flags has CSV_BATCH_FLAG_ESCAPED. Writes at most
+ * out_size - 1 bytes plus a NUL terminator and returns the unescaped length.
+ */
+static inline size_t rune_csv_unescape(StringView cell, char* out, size_t out_size) {
+    size_t n = 0;
+    size_t i;
+    for (i = 0; i < cell.len; ++i) {
+        if (cell.ptr[i] == '"' && i + 1 < cell.len && cell.ptr[i + 1] == '"') {
+            ++i;
+        }
+        if (n + 1 < out_size) {
+            out[n] = cell.ptr[i];
+        }
+        ++n;
+    }
+    if (out_size > 0) {
+        out[n < out_size ? n : out_size - 1] = '\0';
+    }
+    return n;
+}
+
 /* ==========================================================================
  * Environment Variable and Settings Access
  * 
@@ -182,6 +633,15 @@
  *   const char* sandbox = host->get_rune_setting("disable_directory_sandboxing");
  *   const char* mcp = host->get_rune_setting("enable_mcp_server");
  *   const char* port = host->get_rune_setting("mcp_server_port");
+ *
+ * Cached access (API version 2) - intern the key once, then refetch only
+ * when the scope's generation moves:
+ *   g_key = host->env_key_intern("MY_VAR");   // once, e.g. in on_load
+ *   uint64_t gen = host->env_generation(ENV_SCOPE_APP);
+ *   if (gen != cache->generation) {
+ *       cache->found = host->env_try_get_key(ENV_SCOPE_APP, g_key, &cache->value);
+ *       cache->generation = gen;
+ *   }
  * ========================================================================== */
 
 /**
@@ -194,6 +654,11 @@
  */
 #define RUNE_ENV_HAS(host, key) ((host)->env_has(key))
 
+/**
+ * RUNE_ENV_TRY_GET - Look up a flow environment variable in one call (API version 2)
+ */
+#define RUNE_ENV_TRY_GET(host, key, out_value) ((host)->env_try_get(ENV_SCOPE_FLOW, key, out_value))
+
 /**
  * Flow Environment Variable Macros
  */
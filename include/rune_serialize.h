@@ -0,0 +1,296 @@
+/**
+ * RUNE Plugin SDK - Binary node state format
+ *
+ * Versioned tag/length/value records for NodeVTable::serialize_to and
+ * NodeVTable::deserialize_from. Writers append straight into the host's
+ * shared flow buffer; readers work in place on the flow file's bytes, so
+ * neither side allocates.
+ *
+ * Layout (all integers little-endian):
+ *
+ *   Header, 8 bytes:
+ *     "RNS"            magic
+ *     uint8   format   RUNE_SERIALIZE_FORMAT_VERSION
+ *     uint16  schema   node-defined state version
+ *     uint16  reserved 0
+ *
+ *   Fields, each an 8-byte header followed by the payload, zero-padded to a
+ *   multiple of RUNE_SERIALIZE_ALIGNMENT bytes:
+ *     uint16  id       node-defined, never reused for a different meaning
+ *     uint8   type     SerializeFieldType
+ *     uint8   reserved 0
+ *     uint32  length   payload bytes, excluding padding
+ *
+ * Readers skip fields with unknown IDs and use defaults for missing ones, so
+ * nodes can add and retire fields without breaking older flows. Because the
+ * host aligns each node's data, payloads start 8-byte aligned and BYTES
+ * fields can be viewed in place as arrays.
+ *
+ * Example:
+ *
+ *   enum { MY_FIELD_COUNT = 1, MY_FIELD_NAME = 2 };
+ *
+ *   static bool my_serialize_to(void* inst, SerializeWriter* w) {
+ *       MyInstance* s = (MyInstance*)inst;
+ *       return rune_ser_write_header(w, 1) &&
+ *              rune_ser_write_u64(w, MY_FIELD_COUNT, s->count) &&
+ *              rune_ser_write_string(w, MY_FIELD_NAME, s->name);
+ *   }
+ *
+ *   static bool my_deserialize_from(void* inst, const uint8_t* data, uint32_t size) {
+ *       MyInstance* s = (MyInstance*)inst;
+ *       SerializeReader r;
+ *       SerializeField f;
+ *       uint32_t cursor = 0;
+ *       if (!rune_ser_read_init(&r, data, size)) {
+ *           return false;
+ *       }
+ *       while (rune_ser_read_next(&r, &cursor, &f)) {
+ *           switch (f.id) {
+ *               case MY_FIELD_COUNT: s->count = rune_ser_field_u64(&f, 0); break;
+ *               case MY_FIELD_NAME:  copy_name(s, rune_ser_field_string(&f, "")); break;
+ *           }
+ *       }
+ *       return true;
+ *   }
+ */
+
+#ifndef RUNE_PLUGIN_SERIALIZE_H
+#define RUNE_PLUGIN_SERIALIZE_H
+
+#include "plugin_api.h"
+
+#include <string.h>
+
+#define RUNE_SERIALIZE_FORMAT_VERSION 1
+#define RUNE_SERIALIZE_HEADER_SIZE    8
+#define RUNE_SERIALIZE_FIELD_SIZE     8
+
+typedef enum SerializeFieldType {
+    SERIALIZE_FIELD_U64    = 1,
+    SERIALIZE_FIELD_I64    = 2,
+    SERIALIZE_FIELD_F64    = 3,
+    SERIALIZE_FIELD_BOOL   = 4,  /* 1-byte payload */
+    SERIALIZE_FIELD_STRING = 5,  /* NUL-terminated; length includes the NUL */
+    SERIALIZE_FIELD_BYTES  = 6
+} SerializeFieldType;
+
+typedef struct SerializeReader {
+    const uint8_t* data;            /* Node data, including the header */
+    uint32_t       size;
+    uint16_t       schema_version;  /* From the header */
+} SerializeReader;
+
+typedef struct SerializeField {
+    uint16_t       id;
+    uint8_t        type;     /* SerializeFieldType */
+    const uint8_t* payload;  /* Points into the reader's data */
+    uint32_t       length;
+} SerializeField;
+
+/* ==========================================================================
+ * Little-endian encoding
+ * ========================================================================== */
+
+static inline void rune_ser_store_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void rune_ser_store_u32(uint8_t* p, uint32_t v) {
+    int i;
+    for (i = 0; i < 4; ++i) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static inline void rune_ser_store_u64(uint8_t* p, uint64_t v) {
+    int i;
+    for (i = 0; i < 8; ++i) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static inline uint16_t rune_ser_load_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t rune_ser_load_u32(const uint8_t* p) {
+    uint32_t v = 0;
+    int i;
+    for (i = 3; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static inline uint64_t rune_ser_load_u64(const uint8_t* p) {
+    uint64_t v = 0;
+    int i;
+    for (i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+/* ==========================================================================
+ * Writing
+ * ========================================================================== */
+
+/**
+ * rune_ser_write_header - Start a node's record; call once, before any field
+ */
+static inline bool rune_ser_write_header(SerializeWriter* writer, uint16_t schema_version) {
+    uint8_t header[RUNE_SERIALIZE_HEADER_SIZE] = {'R', 'N', 'S', RUNE_SERIALIZE_FORMAT_VERSION, 0, 0, 0, 0};
+    rune_ser_store_u16(header + 4, schema_version);
+    return writer->append(writer, header, RUNE_SERIALIZE_HEADER_SIZE);
+}
+
+/**
+ * rune_ser_write_field - Append one field with an arbitrary payload
+ */
+static inline bool rune_ser_write_field(SerializeWriter* writer, uint16_t id, SerializeFieldType type,
+                                        const void* payload, uint32_t length) {
+    static const uint8_t zeros[RUNE_SERIALIZE_ALIGNMENT] = {0};
+    uint8_t header[RUNE_SERIALIZE_FIELD_SIZE] = {0};
+    uint32_t pad = (RUNE_SERIALIZE_ALIGNMENT - (length % RUNE_SERIALIZE_ALIGNMENT)) % RUNE_SERIALIZE_ALIGNMENT;
+
+    rune_ser_store_u16(header, id);
+    header[2] = (uint8_t)type;
+    rune_ser_store_u32(header + 4, length);
+
+    return writer->append(writer, header, RUNE_SERIALIZE_FIELD_SIZE) &&
+           (length == 0 || writer->append(writer, payload, length)) &&
+           (pad == 0 || writer->append(writer, zeros, pad));
+}
+
+static inline bool rune_ser_write_u64(SerializeWriter* writer, uint16_t id, uint64_t value) {
+    uint8_t buf[8];
+    rune_ser_store_u64(buf, value);
+    return rune_ser_write_field(writer, id, SERIALIZE_FIELD_U64, buf, 8);
+}
+
+static inline bool rune_ser_write_i64(SerializeWriter* writer, uint16_t id, int64_t value) {
+    uint8_t buf[8];
+    rune_ser_store_u64(buf, (uint64_t)value);
+    return rune_ser_write_field(writer, id, SERIALIZE_FIELD_I64, buf, 8);
+}
+
+static inline bool rune_ser_write_f64(SerializeWriter* writer, uint16_t id, double value) {
+    uint64_t bits;
+    uint8_t buf[8];
+    memcpy(&bits, &value, sizeof(bits));
+    rune_ser_store_u64(buf, bits);
+    return rune_ser_write_field(writer, id, SERIALIZE_FIELD_F64, buf, 8);
+}
+
+static inline bool rune_ser_write_bool(SerializeWriter* writer, uint16_t id, bool value) {
+    uint8_t b = value ? 1 : 0;
+    return rune_ser_write_field(writer, id, SERIALIZE_FIELD_BOOL, &b, 1);
+}
+
+static inline bool rune_ser_write_string(SerializeWriter* writer, uint16_t id, const char* value) {
+    const char* s = value ? value : "";
+    return rune_ser_write_field(writer, id, SERIALIZE_FIELD_STRING, s, (uint32_t)strlen(s) + 1);
+}
+
+static inline bool rune_ser_write_bytes(SerializeWriter* writer, uint16_t id, const void* data, uint32_t length) {
+    return rune_ser_write_field(writer, id, SERIALIZE_FIELD_BYTES, data, length);
+}
+
+/* ==========================================================================
+ * Reading (in place)
+ * ========================================================================== */
+
+/**
+ * rune_ser_read_init - Validate the header; false if data is not in this format
+ */
+static inline bool rune_ser_read_init(SerializeReader* reader, const uint8_t* data, uint32_t size) {
+    if (!data || size < RUNE_SERIALIZE_HEADER_SIZE ||
+        data[0] != 'R' || data[1] != 'N' || data[2] != 'S' ||
+        data[3] != RUNE_SERIALIZE_FORMAT_VERSION) {
+        return false;
+    }
+    reader->data = data;
+    reader->size = size;
+    reader->schema_version = rune_ser_load_u16(data + 4);
+    return true;
+}
+
+/**
+ * rune_ser_read_next - Iterate fields in order
+ *
+ * Start *cursor at 0. Returns false at the end of the data or on a truncated
+ * field, so a single loop over all fields is one linear pass.
+ */
+static inline bool rune_ser_read_next(const SerializeReader* reader, uint32_t* cursor, SerializeField* out) {
+    uint32_t offset = *cursor ? *cursor : RUNE_SERIALIZE_HEADER_SIZE;
+    uint32_t length;
+    uint32_t padded;
+
+    if (offset > reader->size || reader->size - offset < RUNE_SERIALIZE_FIELD_SIZE) {
+        return false;
+    }
+    length = rune_ser_load_u32(reader->data + offset + 4);
+    if (length > reader->size - offset - RUNE_SERIALIZE_FIELD_SIZE) {
+        return false;
+    }
+
+    out->id = rune_ser_load_u16(reader->data + offset);
+    out->type = reader->data[offset + 2];
+    out->payload = reader->data + offset + RUNE_SERIALIZE_FIELD_SIZE;
+    out->length = length;
+
+    padded = length + (RUNE_SERIALIZE_ALIGNMENT - (length % RUNE_SERIALIZE_ALIGNMENT)) % RUNE_SERIALIZE_ALIGNMENT;
+    *cursor = offset + RUNE_SERIALIZE_FIELD_SIZE + padded;
+    return true;
+}
+
+/**
+ * rune_ser_read_find - Look up one field by ID (scans from the start)
+ */
+static inline bool rune_ser_read_find(const SerializeReader* reader, uint16_t id, SerializeField* out) {
+    uint32_t cursor = 0;
+    while (rune_ser_read_next(reader, &cursor, out)) {
+        if (out->id == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Typed accessors return the fallback when the field has another type */
+
+static inline uint64_t rune_ser_field_u64(const SerializeField* field, uint64_t fallback) {
+    return (field->type == SERIALIZE_FIELD_U64 && field->length == 8) ? rune_ser_load_u64(field->payload) : fallback;
+}
+
+static inline int64_t rune_ser_field_i64(const SerializeField* field, int64_t fallback) {
+    return (field->type == SERIALIZE_FIELD_I64 && field->length == 8) ? (int64_t)rune_ser_load_u64(field->payload) : fallback;
+}
+
+static inline double rune_ser_field_f64(const SerializeField* field, double fallback) {
+    uint64_t bits;
+    double value;
+    if (field->type != SERIALIZE_FIELD_F64 || field->length != 8) {
+        return fallback;
+    }
+    bits = rune_ser_load_u64(field->payload);
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline bool rune_ser_field_bool(const SerializeField* field, bool fallback) {
+    return (field->type == SERIALIZE_FIELD_BOOL && field->length == 1) ? field->payload[0] != 0 : fallback;
+}
+
+/* Points into the reader's data; valid only as long as that data is */
+static inline const char* rune_ser_field_string(const SerializeField* field, const char* fallback) {
+    if (field->type != SERIALIZE_FIELD_STRING || field->length == 0 ||
+        field->payload[field->length - 1] != '\0') {
+        return fallback;
+    }
+    return (const char*)field->payload;
+}
+
+#endif /* RUNE_PLUGIN_SERIALIZE_H */